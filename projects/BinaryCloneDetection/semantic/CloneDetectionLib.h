@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <vector>
 #include <ostream>
+#include <fstream>
 #include <map>
 
 namespace CloneDetection {
@@ -172,6 +173,92 @@ std::ostream& operator<<(std::ostream&, const Exception&);
 
 
 
+/*******************************************************************************************************************************
+ *                                      Result shards
+ *******************************************************************************************************************************/
+
+/** Append-only store for rows that parallel workers would otherwise insert into the database.
+ *
+ *  SQLite3 serializes all writers, so parallel workers that insert their results directly into an SQLite3 database spend most
+ *  of their time waiting for each other, and a commit fails while other processes hold read transactions.  Instead, each worker
+ *  process can write its rows, including its own row of the semantic_history table (see start_command() and finish_command()),
+ *  to its own files (shards) in a directory shared by all workers, and use the database only for reading.  The shards are
+ *  loaded into the database by a single process with merge_shards() when the workers are done.
+ *
+ *  Each commit() writes one shard file that contains all rows written since the previous commit, grouped into one section per
+ *  table.  A section starts with a line containing the table name, optionally followed by the parenthesized, comma-separated
+ *  list of columns that the rows provide, and the number of rows, separated from the name by a space.  Without a column list
+ *  the rows provide values for all columns in schema order, as for bulk loading.  Each of the following lines is one row of
+ *  comma-separated values.  Values are inserted as text exactly like SqlDatabase::Transaction::bulk_load() does, so an empty
+ *  value is an empty string, not NULL.  Values must not contain commas or line feeds.  The notation and command of the
+ *  semantic_history row are base64-encoded since they are free-form text; merge_shards() decodes them.
+ *
+ *  The file is written under a temporary name and renamed by commit(), so merge_shards() sees either all or none of the rows of
+ *  a checkpoint, and never sees rows of a worker that failed before committing them.  Each writer must be used by only one
+ *  process; create it after forking. */
+class ShardWriter {
+public:
+    /** This process' row of the semantic_history table.  Once the hashkey is set (by start_command()) the row is written with
+     *  every commit() so that the rows of each checkpoint refer to an existing command; merge_shards() inserts it once and
+     *  updates the end time and notation from later checkpoints. */
+    struct HistoryRow {
+        int64_t hashkey;                        // zero if this writer has no history row
+        time_t begin_time;
+        time_t end_time;                        // zero until finish_command()
+        std::string notation;
+        std::string command;
+        HistoryRow(): hashkey(0), begin_time(0), end_time(0) {}
+    };
+
+    /** Start writing shards into the specified directory, which is created if necessary. */
+    explicit ShardWriter(const std::string &directory);
+
+    /** The destructor discards all rows written since the last commit(). */
+    ~ShardWriter() { rollback(); }
+
+    /** Return the stream to which rows for the specified table are written.  The @p columns are the comma-separated column
+     *  names of the rows, or empty if the rows have values for all columns.  All rows of a table written between two commits
+     *  must provide the same columns. */
+    std::ostream& table(const std::string &tablename, const std::string &columns="");
+
+    /** Append all rows from a stream of comma-separated values that has values for all columns of the table, such as the
+     *  temporary file of a WriteOnlyTable. */
+    void append(const std::string &tablename, std::istream&);
+
+    /** The semantic_history row of the command writing these shards. */
+    HistoryRow& history() { return history_row; }
+
+    /** Make all rows written since the last commit visible to merge_shards(). */
+    void commit();
+
+    /** Discard all rows written since the last commit. */
+    void rollback();
+
+private:
+    struct Shard {
+        std::string columns;
+        std::string filename;                   // temporary file holding the rows until they are committed
+        std::ofstream *stream;
+    };
+    typedef std::map<std::string/*tablename*/, Shard> Shards;
+
+    std::string directory;
+    std::string prefix;                         // identifies this writer in file names
+    Shards shards;
+    HistoryRow history_row;
+    size_t sequence;                            // number of commits, to make file names unique
+
+    ShardWriter(const ShardWriter&);            // not copyable
+    ShardWriter& operator=(const ShardWriter&);
+};
+
+/** Insert the rows of all committed shards in a directory into the database.  The names of the shard files whose rows were
+ *  inserted are appended to @p merged; the caller should remove those files after committing the transaction. Returns the
+ *  number of rows that were inserted, not counting semantic_history rows. */
+size_t merge_shards(const SqlDatabase::TransactionPtr&, const std::string &directory, std::vector<std::string> &merged/*out*/);
+
+
+
 /*******************************************************************************************************************************
  *                                      Large Table Output
  *******************************************************************************************************************************/
@@ -226,6 +313,19 @@ public:
         }
     }
 
+    /** Move pending data into shards instead of the database. */
+    void flush(ShardWriter &shards) {
+        if (!empty()) {
+            f.close();
+            std::ifstream fin(filename);
+            shards.append(tablename, fin);
+            fin.close();
+            unlink(filename);
+            filename[0] = '\0';
+            nrows = 0;
+        }
+    }
+
 private:
     void open_backing() {
         if (!f.is_open()) {
@@ -422,8 +522,11 @@ public:
     /** Total number of addresses executed. */
     size_t total_ninsns() const;
 
-    /** Flush pending data to the database and clear this object. */
+    /** Flush pending data to the database or shards and clear this object.
+     * @{ */
     void flush(const SqlDatabase::TransactionPtr&);
+    void flush(ShardWriter&);
+    /** @} */
 
    /** Returns the coverage ratio for a function.  The return value is the number of unique instructions of the function that
      *  were executed divided by the total number of instructions in the function. This InsnCoverage object may contain
@@ -433,6 +536,8 @@ public:
     /** Get instructions covered by trace in the order in which they were encountered.
      */
     void get_instructions(std::vector<SgAsmInstruction*>& insns, SgAsmInterpretation* interp, SgAsmFunction* top = NULL);
+private:
+    void insert_pending();                      // add the hits since the last flush to the pending rows
 protected:
     int func_id, igroup_id;
 
@@ -513,8 +618,11 @@ public:
         return rows[idx];
     }
 
-    /** Flush all pending data to the database. */
+    /** Flush all pending data to the database or shards.
+     * @{ */
     void flush(const SqlDatabase::TransactionPtr&);
+    void flush(ShardWriter&);
+    /** @} */
 
 protected:
     bool keep_in_memory;                // keep copies of rows in memory until clear() is called.
@@ -878,8 +986,11 @@ public:
     /** Find the output group for the given hash key. Returns NULL if the hashkey does not exist. */
     const OutputGroup* lookup(int64_t hashkey) const;
 
-    /** Save locally-inserted OutputGroup objects to the database. */
+    /** Save locally-inserted OutputGroup objects to the database or shards.
+     * @{ */
     void save(const SqlDatabase::TransactionPtr&);
+    void save(ShardWriter&);
+    /** @} */
 
     /** Generate another hash key. */
     int64_t generate_hashkey();
@@ -2542,6 +2653,14 @@ int64_t start_command(const SqlDatabase::TransactionPtr&, int argc, char *argv[]
  *  The description can be updated if desired. */
 void finish_command(const SqlDatabase::TransactionPtr&, int64_t hashkey, const std::string &desc="");
 
+/** Start the command by setting the semantic_history row of the shard writer instead of inserting it into the database.  The
+ *  row is inserted by merge_shards(). Returns the hashkey ID for this command. */
+int64_t start_command(ShardWriter&, int argc, char *argv[], const std::string &desc, time_t begin=0);
+
+/** Called just before a command's final ShardWriter::commit().  Like finish_command() for the database, but updates the
+ *  semantic_history row of the shard writer. */
+void finish_command(ShardWriter&, int64_t hashkey, const std::string &desc="");
+
 /** Return the name of the file that contains the specified header.  If basename is true then return only the base name, not
  *  any directory components. */
 std::string filename_for_header(SgAsmGenericHeader*, bool basename=false);
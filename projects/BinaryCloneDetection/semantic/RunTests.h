@@ -38,6 +38,7 @@ struct Switches {
     size_t nprocs;                                      // number of parallel processes to fork
     std::vector<std::string> signature_components;      /**< How should the signature vectors be computed */
     PathSyntactic path_syntactic;                       /**< How to compute path sensistive syntactic signature */
+    std::string shard_dir;                              /**< Write results to shards in this directory instead of database */
 };
 
 struct WorkItem {
@@ -77,13 +78,14 @@ OutputGroup fuzz_test(SgAsmInterpretation *interp, SgAsmFunction *function, Inpu
                       ConsumedInputs &consumed_inputs);
 SqlDatabase::TransactionPtr checkpoint(const SqlDatabase::TransactionPtr &tx, OutputGroups &ogroups, Tracer &tracer,
                                        InsnCoverage &insn_coverage, DynamicCallGraph &dynamic_cg, ConsumedInputs &consumed_inputs,
-                                       Progress *progress, size_t ntests_ran, int64_t cmd_id);
+                                       Progress *progress, size_t ntests_ran, int64_t cmd_id, ShardWriter *shards=NULL);
+void save_funcpartials(const SqlDatabase::TransactionPtr &tx, const FuncAnalyses&, ShardWriter *shards=NULL);
 void runOneTest(SqlDatabase::TransactionPtr tx, const WorkItem &workItem, PointerDetectors &pointers, SgAsmFunction *func,
                 const FunctionIdMap &function_ids, InsnCoverage &insn_coverage /*in,out*/, DynamicCallGraph &dynamic_cg /*in,out*/,
                 Tracer &tracer /*in,out*/, ConsumedInputs &consumed_inputs /*in,out*/, SgAsmInterpretation *interp,
                 const Rose::BinaryAnalysis::Disassembler::AddressSet &whitelist_exports, int64_t cmd_id, InputGroup &igroup,
                 FuncAnalyses funcinfo, const InstructionProvidor &insns, const MemoryMap::Ptr &ro_map,
-                const AddressIdMap &entry2id, OutputGroups &ogroups /*in,out*/);
+                const AddressIdMap &entry2id, OutputGroups &ogroups /*in,out*/, ShardWriter *shards=NULL);
 
 } // namespace
 } // namespace
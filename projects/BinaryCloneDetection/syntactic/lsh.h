@@ -14,6 +14,10 @@
 #include <boost/lexical_cast.hpp>
 
 #include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "vectorCompression.h"
 #include "callLSH.h" // To get insert_into_clusters and insert_into_postprocessed_clusters
@@ -86,6 +90,11 @@ private:
 public:
     void compute_hashes(const scoped_array_with_size<uint8_t>& compressedCounts,
                         const boost::scoped_array<size_t>& hashes) const;
+
+    // Appends up to numProbes (table number, bucket number) pairs per table for the buckets next to the query's own bucket:
+    // those reached by flipping the sampled bits whose compare values are closest to the query's vector elements.
+    void compute_probe_hashes(const scoped_array_with_size<uint8_t>& compressedCounts, size_t numProbes,
+                              std::vector<std::pair<size_t, size_t> >& probes) const;
 };
 
 class StableDistributionHashFunctionSet {
@@ -100,90 +109,158 @@ public:
                                       size_t numVectorElements, size_t hashTableNumBuckets);
 private:
     void create_hash_functions();
+    size_t combine_hash_components(size_t functionIndex, const int64_t components[]) const;
 
 public:
     void compute_hashes(const scoped_array_with_size<uint8_t>& compressedCounts, const boost::scoped_array<size_t>& hashes) const;
+
+    // Appends up to numProbes (table number, bucket number) pairs per table for the buckets next to the query's own bucket:
+    // those reached by moving one projection by one slot towards the slot boundary closest to the query.
+    void compute_probe_hashes(const scoped_array_with_size<uint8_t>& compressedCounts, size_t numProbes,
+                              std::vector<std::pair<size_t, size_t> >& probes) const;
 };
 
+// An array of plain values that lives either in memory or, if a spill directory is given, in an unlinked temporary file in
+// that directory which is mapped into memory.  The operating system can page a file-backed array out, so tables larger than
+// main memory can be built.
+template <typename T>
+class SpillableArray {
+    T* data;
+    size_t theSize, capacity;
+    int fd; // -1 for arrays that live in memory
+
+public:
+    explicit SpillableArray(const std::string& spillDirectory = "")
+        : data(NULL), theSize(0), capacity(0), fd(-1) {
+        if (!spillDirectory.empty()) {
+            std::string name = spillDirectory + "/lsh-buckets-XXXXXX";
+            std::vector<char> nameBuffer(name.begin(), name.end());
+            nameBuffer.push_back('\0');
+            fd = mkstemp(&nameBuffer[0]);
+            if (fd < 0) {
+                perror(("Cannot create spill file in " + spillDirectory).c_str());
+                abort();
+            }
+            unlink(&nameBuffer[0]); // The file is removed when it is closed
+        }
+    }
+
+    ~SpillableArray() {
+        release();
+        if (fd >= 0)
+            close(fd);
+    }
+
+    size_t size() const {return theSize;}
+    T& operator[](size_t i) {return data[i];}
+    const T& operator[](size_t i) const {return data[i];}
+
+    // New elements are set to initialValue
+    void resize(size_t newSize, const T& initialValue = T()) {
+        if (newSize > capacity)
+            reserve(std::max(newSize, 2 * capacity));
+        for (size_t i = theSize; i < newSize; ++i)
+            data[i] = initialValue;
+        theSize = newSize;
+    }
+
+private:
+    void reserve(size_t newCapacity) {
+        if (fd < 0) {
+            T* newData = static_cast<T*>(realloc(data, newCapacity * sizeof(T)));
+            if (newData == NULL) {
+                std::cerr << "Out of memory for hash table buckets; use a spill directory" << std::endl;
+                abort();
+            }
+            data = newData;
+        } else {
+            release();
+            if (ftruncate(fd, newCapacity * sizeof(T)) != 0) {
+                perror("Cannot grow spill file");
+                abort();
+            }
+            void* p = mmap(NULL, newCapacity * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                perror("Cannot map spill file");
+                abort();
+            }
+            data = static_cast<T*>(p);
+        }
+        capacity = newCapacity;
+    }
+
+    void release() {
+        if (data == NULL)
+            return;
+        if (fd < 0) {
+            free(data);
+        } else {
+            munmap(data, capacity * sizeof(T));
+        }
+        data = NULL;
+    }
+
+    SpillableArray(const SpillableArray<T>&); // Not copyable
+    SpillableArray<T>& operator=(const SpillableArray<T>&);
+};
+
+// The buckets of a group of hash tables.  Each bucket is a list of blocks of blockSize values that grows as needed, so a
+// bucket never overflows.  All storage can be spilled to memory-mapped files (see SpillableArray).
 template <typename Value>
 class HashTableGroup {
-    const size_t numHashTables, numBuckets, maxBucketSize, singleHashTableSize;
-    boost::scoped_array<Value> table;
-    // Values are 0..maxBucketSize-1 for non-full buckets, maxBucketSize for a full bucket that hasn't overflowed yet, and
-    // maxBucketSize+1 for a bucket that has overflowed into later buckets
-    boost::scoped_array<size_t> bucketSizes;
+    static const uint32_t noBlock = 0xffffffff;
+    const size_t numHashTables, numBuckets, blockSize;
+    SpillableArray<uint32_t> bucketSizes;
+    // The most recently allocated block of each bucket; it is the only block of the bucket that may not be full
+    SpillableArray<uint32_t> firstBlocks;
+    // The next (older) block of the same bucket, for each block
+    SpillableArray<uint32_t> nextBlocks;
+    SpillableArray<Value> values;
 
 public:
-    HashTableGroup(size_t numHashTables, size_t numBuckets, size_t maxBucketSize)
-        : numHashTables(numHashTables), numBuckets(numBuckets), maxBucketSize(maxBucketSize),
-          singleHashTableSize(numBuckets * maxBucketSize), table(new Value[numHashTables * numBuckets * maxBucketSize]),
-          bucketSizes(new size_t[numHashTables * numBuckets]) {
-        memset(bucketSizes.get(), 0, sizeof(size_t) * numHashTables * numBuckets);
+    HashTableGroup(size_t numHashTables, size_t numBuckets, size_t blockSize, const std::string& spillDirectory = "")
+        : numHashTables(numHashTables), numBuckets(numBuckets), blockSize(std::max(blockSize, (size_t)1)),
+          bucketSizes(spillDirectory), firstBlocks(spillDirectory), nextBlocks(spillDirectory), values(spillDirectory) {
+        bucketSizes.resize(numHashTables * numBuckets, 0);
+        firstBlocks.resize(numHashTables * numBuckets, noBlock);
     }
 
     void insert(size_t tableNum, size_t hashCode, const Value& v) {
-        size_t actualBucket = hashCode;
-        size_t* bucketSizePtr = &bucketSizes[tableNum * numBuckets + actualBucket];
-        while (*bucketSizePtr >= maxBucketSize) {
-            *bucketSizePtr = maxBucketSize + 1; // Mark bucket as overflowed if it wasn't already
-            ++actualBucket;
-            ++bucketSizePtr;
-            if (actualBucket >= numBuckets) {
-                actualBucket -= numBuckets;
-                bucketSizePtr -= numBuckets;
-            }
-            if (actualBucket == hashCode) {
-                std::cerr << "Hash table full" << std::endl;
+        const size_t bucket = tableNum * numBuckets + hashCode;
+        const size_t offset = bucketSizes[bucket] % blockSize;
+        if (offset == 0) { // The first block is full, or the bucket has none yet
+            const size_t block = nextBlocks.size();
+            if (block >= noBlock) {
+                std::cerr << "Too many hash table blocks; use a larger bucket size" << std::endl;
                 abort();
             }
+            nextBlocks.resize(block + 1, firstBlocks[bucket]);
+            values.resize(values.size() + blockSize);
+            firstBlocks[bucket] = block;
         }
-        assert (*bucketSizePtr < maxBucketSize);
-        table[tableNum * singleHashTableSize + actualBucket * maxBucketSize + *bucketSizePtr] = v;
-        ++(*bucketSizePtr);
+        values[firstBlocks[bucket] * blockSize + offset] = v;
+        ++bucketSizes[bucket];
     }
 
     void append_bucket_contents(size_t tableNum, size_t hashCode, std::vector<Value>& contents) const {
-        size_t bucketNum = hashCode;
-        while (true) { // Iterate through all overflowed buckets and the first non-full bucket found
-            const Value* const bucketBase = &table[tableNum * singleHashTableSize + bucketNum * maxBucketSize];
-            const size_t rawBucketSize = bucketSizes[tableNum * numBuckets + bucketNum];
-            const bool bucketOverflowed = (rawBucketSize > maxBucketSize);
-            // The ?: expression here prevents copying too many elements from overflowed buckets
-            const size_t bucketSize = bucketOverflowed ? maxBucketSize : rawBucketSize;
-            contents.insert(contents.end(), bucketBase, bucketBase + bucketSize);
-            if (bucketOverflowed) {
-                // std::cerr << "Need to scan bucket after full bucket " << bucketNum << std::endl;
-                ++bucketNum;
-                if (bucketNum >= numBuckets) bucketNum -= numBuckets;
-                continue;
-            } else {
-                break;
-            }
+        const size_t bucket = tableNum * numBuckets + hashCode;
+        size_t remaining = bucketSizes[bucket];
+        uint32_t block = firstBlocks[bucket];
+        size_t count = (remaining % blockSize == 0) ? blockSize : remaining % blockSize;
+        while (remaining > 0) {
+            const Value* const blockBase = &values[block * blockSize];
+            contents.insert(contents.end(), blockBase, blockBase + count);
+            remaining -= count;
+            block = nextBlocks[block];
+            count = blockSize;
         }
     }
 
     size_t get_biggest_bucket() const {
-        size_t currentMax =0;
-        for (size_t i = 0; i < numHashTables; ++i) {
-            for (size_t j = 0; j < numBuckets; ++j) {
-                size_t totalBucketSize = 0;
-                size_t j2 = j;
-                while (true) {
-                    const size_t rawBucketSize = bucketSizes[i * numBuckets + j2];
-                    const bool bucketOverflowed = (rawBucketSize > maxBucketSize);
-                    const size_t bucketSize = bucketOverflowed ? maxBucketSize : rawBucketSize;
-                    totalBucketSize += bucketSize;
-
-                    if (!bucketOverflowed) break;
-                    j2 = (j2 + 1) % numBuckets;
-                    if (j2 == j) {
-                        std::cerr << "All hash table buckets are overfull; this is not allowed" << std::endl;
-                        abort();
-                    }
-                }
-
-                if(totalBucketSize>currentMax) currentMax = totalBucketSize;
-            }
+        size_t currentMax = 0;
+        for (size_t i = 0; i < numHashTables * numBuckets; ++i) {
+            if (bucketSizes[i] > currentMax)
+                currentMax = bucketSizes[i];
         }
         return currentMax;
     }
@@ -193,29 +270,18 @@ public:
         for (size_t i = 0; i < numHashTables; ++i) {
             o << "Table " << i << ":\n";
             std::map<size_t, size_t> sizes;
-            for (size_t j = 0; j < numBuckets; ++j) {
-                size_t totalBucketSize = 0;
-                size_t j2 = j;
-                while (true) {
-                    const size_t rawBucketSize = bucketSizes[i * numBuckets + j2];
-                    const bool bucketOverflowed = (rawBucketSize > maxBucketSize);
-                    const size_t bucketSize = bucketOverflowed ? maxBucketSize : rawBucketSize;
-                    totalBucketSize += bucketSize;
-                    if (!bucketOverflowed) break;
-                    j2 = (j2 + 1) % numBuckets;
-                    if (j2 == j) {
-                        std::cerr << "All hash table buckets are overfull; this is not allowed" << std::endl;
-                        abort();
-                    }
-                }
-                ++sizes[totalBucketSize];
-            }
+            for (size_t j = 0; j < numBuckets; ++j)
+                ++sizes[bucketSizes[i * numBuckets + j]];
             for (std::map<size_t, size_t>::reverse_iterator it = sizes.rbegin(); it != sizes.rend(); ++it)
-                o << "Spill size " << it->first << " occurs for " << it->second << "bucket(s)\n";
+                o << "Bucket size " << it->first << " occurs for " << it->second << " bucket(s)\n";
         }
+        o << "Blocks of " << blockSize << " element(s) in use: " << nextBlocks.size() << "\n";
     }
 };
 
+template <typename Value>
+const uint32_t HashTableGroup<Value>::noBlock;
+
 struct L1DistanceObject {
     double operator()(const scoped_array_with_size<uint8_t>& a, const boost::scoped_array<uint16_t>& b) const;
 };
@@ -228,6 +294,10 @@ class LSHTableBase {
 public:
     virtual ~LSHTableBase() {}
     virtual std::vector<std::pair<size_t, double> > query(size_t i) const = 0;
+
+    // Runs query() for each of the indexes on numThreads threads; results[j] is the result for indexes[j].
+    void query_batch(const std::vector<size_t>& indexes, std::vector<std::vector<std::pair<size_t, double> > >& results,
+                     size_t numThreads) const;
 };
 
 template <typename HashFunctionGenerator, typename DistanceFunc>
@@ -238,12 +308,17 @@ class LSHTable: public LSHTableBase {
     HashTableGroup<size_t> hashTables;
     size_t l, numVectorElements;
     double distBound;
+    size_t numProbes;
 
 public:
+    // bucketBlockSize is the allocation unit of the buckets; numProbes is the number of additional buckets per table looked
+    // at by queries (multi-probe LSH), which achieves the same recall with fewer tables.
     LSHTable(const scoped_array_with_size<VectorEntry>& vectors, const DistanceFunc& distance, size_t k, size_t l, double r,
-             size_t numVectorElements, size_t numBuckets, size_t maxBucketSize, double distBound)
+             size_t numVectorElements, size_t numBuckets, size_t bucketBlockSize, double distBound, size_t numProbes = 0,
+             const std::string& spillDirectory = "")
         : vectors(vectors), hashFunctions(vectors, k, l, r, numVectorElements, numBuckets), distance(distance),
-          hashTables(l, numBuckets, maxBucketSize), l(l), numVectorElements(numVectorElements), distBound(distBound) {
+          hashTables(l, numBuckets, bucketBlockSize, spillDirectory), l(l), numVectorElements(numVectorElements),
+          distBound(distBound), numProbes(numProbes) {
         //Loop to insert into the hash table according to distance
         for (size_t i = 0; i < vectors.size(); ++i) {
             const VectorEntry& ve = vectors[i];
@@ -276,6 +351,12 @@ public:
             size_t bucketNum = hashes[hashNum];
             hashTables.append_bucket_contents(hashNum, bucketNum, bucketContents);
         }
+        if (numProbes > 0) {
+            std::vector<std::pair<size_t, size_t> > probes;
+            hashFunctions.compute_probe_hashes(ve.compressedCounts, numProbes, probes);
+            for (size_t p = 0; p < probes.size(); ++p)
+                hashTables.append_bucket_contents(probes[p].first, probes[p].second, bucketContents);
+        }
         boost::scoped_array<uint16_t> uncompressedVectorI(new uint16_t[numVectorElements]);
         decompressVector(ve.compressedCounts.get(), ve.compressedCounts.size(), uncompressedVectorI.get());
         // Remove duplicates to avoid distance computations
@@ -37,7 +37,7 @@ class AbstractValue {
   typedef uint16_t TypeSize;
   friend bool strictWeakOrderingIsSmaller(const AbstractValue& c1, const AbstractValue& c2);
   friend bool strictWeakOrderingIsEqual(const AbstractValue& c1, const AbstractValue& c2);
-  enum ValueType { BOT, INTEGER, FLOAT, PTR, REF, TOP};
+  enum ValueType : uint8_t { BOT, INTEGER, FLOAT, PTR, REF, TOP};
   AbstractValue();
   AbstractValue(bool val);
   // type conversion
@@ -67,16 +67,16 @@ class AbstractValue {
   // uninitilized explicitly. A declaration (without initializer)
   // should use this function to model the semantics of an undefined value.
   bool isUndefined() const; 
-  bool isTop() const;
-  bool isTrue() const;
-  bool isFalse() const;
-  bool isBot() const;
+  bool isTop() const { return valueType==TOP; }
+  bool isTrue() const { return valueType==INTEGER && intValue!=0; }
+  bool isFalse() const { return valueType==INTEGER && intValue==0; }
+  bool isBot() const { return valueType==BOT; }
   // determines whether the value is known and constant. Otherwise it can be bot or top.
-  bool isConstInt() const;
+  bool isConstInt() const { return valueType==INTEGER; }
   // currently identical to isPtr() but already used where one unique value is required
-  bool isConstPtr() const;
-  bool isPtr() const;
-  bool isNullPtr() const;
+  bool isConstPtr() const { return valueType==PTR; }
+  bool isPtr() const { return valueType==PTR; }
+  bool isNullPtr() const { return valueType==INTEGER && intValue==0; }
   AbstractValue operatorNot();
   AbstractValue operatorUnaryMinus(); // unary minus
   AbstractValue operatorOr(AbstractValue other);
@@ -125,7 +125,7 @@ class AbstractValue {
   friend istream& operator>>(istream& os, AbstractValue& value);
   void fromStream(istream& is);
 
-  ValueType getValueType() const;
+  ValueType getValueType() const { return valueType; }
   int getIntValue() const;
   std::string getFloatValueString() const;
 
@@ -142,20 +142,21 @@ class AbstractValue {
 
   // deprecated (use getTypeSize() instead)
   TypeSize getValueSize() const; 
-  TypeSize getTypeSize() const;
+  TypeSize getTypeSize() const { return typeSize; }
   void setTypeSize(TypeSize valueSize);
   static void setTypeSizeMapping(CodeThorn::SgTypeSizeMapping* typeSizeMapping);
   static CodeThorn::SgTypeSizeMapping* getTypeSizeMapping();
   static bool approximatedBy(AbstractValue val1, AbstractValue val2);
   static AbstractValue combine(AbstractValue val1, AbstractValue val2);
  private:
+  // 16 bytes: the integer value (or pointer offset) and the floating-point value share their storage
   ValueType valueType;
-  CodeThorn::VariableId variableId;
-  // union required
-  long long int intValue=0;
-  long double floatValue=0.0;
-
   TypeSize typeSize=0;
+  CodeThorn::VariableId variableId;
+  union {
+    long long int intValue=0;
+    double floatValue;
+  };
   static CodeThorn::SgTypeSizeMapping* _typeSizeMapping;
 };
 
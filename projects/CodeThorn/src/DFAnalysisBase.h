@@ -11,7 +11,7 @@
 #include <string>
 #include "Labeler.h"
 #include "CFAnalysis.h"
-#include "WorkListSeq.h"
+#include "WorkListPrio.h"
 #include "CollectionOperators.h"
 #include "DFTransferFunctions.h"
 #include "PASolver1.h"
@@ -89,7 +89,7 @@ class DFAnalysisBase {
   long _numberOfLabels=0;
   vector<Lattice*> _analyzerDataPreInfo;
   vector<Lattice*> _analyzerDataPostInfo;
-  WorkListSeq<Edge> _workList;
+  WorkListPrio<Edge> _workList;
   void setInitialElementFactory(PropertyStateFactory*);
   PropertyStateFactory* getInitialElementFactory();
 
@@ -151,6 +151,9 @@ namespace CodeThorn {
     // evaluation functions
     list<SingleEvalResultConstInt> evalConditionalExpr(SgConditionalExp* node, EState estate, EvalMode mode=MODE_VALUE);
     list<SingleEvalResultConstInt> evaluateShortCircuitOperators(SgNode* node,EState estate, EvalMode mode=MODE_VALUE);
+    // computes the result of an arithmetic, bitwise, or relational operator on two concrete integer values.
+    // Returns false if the operator is not handled (the generic evaluation function must be used).
+    bool evalConstIntBinaryOp(SgNode* node, const AbstractValue& lhs, const AbstractValue& rhs, AbstractValue& result);
 
     list<SingleEvalResultConstInt> evalEqualOp(SgEqualityOp* node,
                                                SingleEvalResultConstInt lhsResult, 
@@ -0,0 +1,71 @@
+#ifndef EXTERNAL_STATE_SET_H
+#define EXTERNAL_STATE_SET_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace CodeThorn {
+
+  /*!
+   * \brief Set of visited states that is kept on disk once it exceeds a memory budget.
+   *
+   * States are fixed-size byte records. New candidate states are buffered in memory and
+   * checked against the visited states in batches (delayed duplicate detection): the
+   * candidates are sorted, a Bloom filter over all visited states sorts out the candidates
+   * that are certainly new, and the remaining ones are checked by a sequential merge scan
+   * over the sorted runs on disk. Every batch of new states becomes a new sorted run; runs
+   * are merged when there are too many of them.
+   */
+  class ExternalStateSet {
+  public:
+    // memoryBudget is in bytes and covers the candidate buffer and the Bloom filter
+    ExternalStateSet(size_t recordSize, size_t memoryBudget, std::string tmpDir="/tmp");
+    ~ExternalStateSet();
+    size_t recordSize() const { return _recordSize; }
+    // adds a state that is checked against the visited states in the next call of detectDuplicates
+    void addCandidate(const unsigned char* record);
+    bool isCandidateBufferFull() const;
+    size_t numberOfCandidates() const { return _candidates.size()/_recordSize; }
+    // removes all candidates, adds those that have not been visited before to the set and
+    // returns them (sorted and without duplicates) in newStates
+    void detectDuplicates(std::vector<unsigned char>& newStates);
+    size_t size() const { return _numberOfStates; }
+    size_t numberOfRuns() const { return _runs.size(); }
+
+  private:
+    struct Run {
+      std::string fileName;
+      size_t numberOfRecords;
+    };
+    void sortAndRemoveDuplicates(std::vector<unsigned char>& records) const;
+    // sets visited[i] for every record i (with maybeVisited[i] set) that is contained in the run
+    void markVisited(const std::vector<unsigned char>& records, const std::vector<char>& maybeVisited,
+                     std::vector<char>& visited, const Run& run) const;
+    void writeRun(const std::vector<unsigned char>& records);
+    void mergeRuns();
+    std::string newRunFileName();
+    uint64_t hash(const unsigned char* record) const;
+    bool bloomFilterContains(const unsigned char* record) const;
+    void bloomFilterInsert(const unsigned char* record);
+
+    size_t _recordSize;
+    size_t _candidateBufferSize;
+    std::vector<unsigned char> _candidates;
+    std::vector<uint64_t> _bloomFilter;
+    size_t _bloomFilterBits;
+    std::vector<Run> _runs;
+    std::string _tmpDir;
+    size_t _runCounter;
+    size_t _numberOfStates;
+    static const size_t maxNumberOfRuns=16;
+    static const int bloomFilterHashes=3;
+
+    ExternalStateSet(const ExternalStateSet&);
+    ExternalStateSet& operator=(const ExternalStateSet&);
+  };
+
+} // end of namespace CodeThorn
+
+#endif
@@ -7,12 +7,27 @@
  * License  : see file LICENSE in the CodeThorn distribution *
  *************************************************************/
 #include <boost/unordered_set.hpp>
+#include <omp.h>
 
 //#define HSET_MAINTAINER_DEBUG_MODE
 
+// hash function object returning a hash value that was computed before entering the critical section
+struct HSetMaintainerPrecomputedHash {
+  HSetMaintainerPrecomputedHash(std::size_t hash):_hash(hash) {}
+  template<typename T> std::size_t operator()(const T&) const { return _hash; }
+ private:
+  std::size_t _hash;
+};
+
 /*! 
   * \author Markus Schordan
   * \date 2012.
+  *
+  * Each maintainer is protected by its own lock (instead of one
+  * critical section shared by all maintainers), and hashing and
+  * copying of keys is done outside of the lock. Threads operating on
+  * different sets (e.g. estates, pstates and transitions) therefore
+  * do not block each other.
  */
 template<typename KeyType,typename HashFun, typename EqualToPred>
 class HSetMaintainer 
@@ -25,13 +40,25 @@ public:
    * \author Marc Jasper
    * \date 2016.
    */
-  HSetMaintainer() { _keepStatesDuringDeconstruction = false; }
+  HSetMaintainer() { _keepStatesDuringDeconstruction = false; omp_init_lock(&_lock); }
 
   /*! 
    * \author Marc Jasper
    * \date 2016.
    */
-  HSetMaintainer(bool keepStates) { _keepStatesDuringDeconstruction = keepStates; }
+  HSetMaintainer(bool keepStates) { _keepStatesDuringDeconstruction = keepStates; omp_init_lock(&_lock); }
+
+  // the lock is not copied, each copy has its own lock
+  HSetMaintainer(const HSetMaintainer& other)
+    : boost::unordered_set<KeyType*,HashFun,EqualToPred>(other),
+      _keepStatesDuringDeconstruction(other._keepStatesDuringDeconstruction) {
+    omp_init_lock(&_lock);
+  }
+  HSetMaintainer& operator=(const HSetMaintainer& other) {
+    boost::unordered_set<KeyType*,HashFun,EqualToPred>::operator=(other);
+    _keepStatesDuringDeconstruction=other._keepStatesDuringDeconstruction;
+    return *this;
+  }
 
   /*! 
    * \author Marc Jasper
@@ -44,6 +71,7 @@ public:
 	delete (*i);
       } 
     }
+    omp_destroy_lock(&_lock);
   }
 
   bool exists(KeyType& s) { 
@@ -71,49 +99,26 @@ public:
   typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
 
   KeyType* determine(KeyType& s) { 
-    KeyType* ret=0;
-    typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
-#pragma omp critical(HASHSET)
-    {
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(&s);
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=const_cast<KeyType*>(*i);
-      } else {
-        ret=0;
-      }
-    }
-    return ret;
+    return const_cast<KeyType*>(findLocked(&s));
   }
 
   const KeyType* determine(const KeyType& s) { 
-    const KeyType* ret=0;
-    typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
-#pragma omp critical(HASHSET)
-    {
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(const_cast<KeyType*>(&s));
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=const_cast<KeyType*>(*i);
-      } else {
-        ret=0;
-      }
-    }
-    return ret;
+    return findLocked(const_cast<KeyType*>(&s));
   }
 
   ProcessingResult process(const KeyType* key) {
+    KeyType* keyPtr=const_cast<KeyType*>(key); // TODO: eliminate const_cast
+    std::size_t hash=hashOf(keyPtr);
     ProcessingResult res2;
-#pragma omp critical(HASHSET)
-    {
-      std::pair<typename HSetMaintainer::iterator, bool> res;
-      typename HSetMaintainer::iterator iter=this->find(const_cast<KeyType*>(key)); // TODO: eliminate const_cast
-      if(iter!=this->end()) {
-        // found it!
-        res=std::make_pair(iter,false);
-      } else {
-        res=this->insert(const_cast<KeyType*>(key)); // TODO: eliminate const_cast
-      }
-      res2=std::make_pair(res.second,*res.first);
+    omp_set_lock(&_lock);
+    typename HSetMaintainer::iterator iter=findWithHash(keyPtr,hash);
+    if(iter!=this->end()) {
+      // found it!
+      res2=std::make_pair(false,*iter);
+    } else {
+      res2=std::make_pair(true,*this->insert(keyPtr).first);
     }
+    omp_unset_lock(&_lock);
     return res2;
   }
   const KeyType* processNewOrExisting(const KeyType* s) {
@@ -124,47 +129,34 @@ public:
   //! <true,const KeyType> if new element was inserted
   //! <false,const KeyType> if element already existed
   ProcessingResult process(KeyType key) {
-    ProcessingResult res2;
-#pragma omp critical(HASHSET)
-    {
-    std::pair<typename HSetMaintainer::iterator, bool> res;
-    typename HSetMaintainer::iterator iter=this->find(&key);
-    if(iter!=this->end()) {
+    std::size_t hash=hashOf(&key);
+    const KeyType* existing=findLocked(&key,hash);
+    if(existing) {
       // found it!
-      res=std::make_pair(iter,false);
-    } else {
-      // converting the stack allocated object to heap allocated
-      // this copies the entire object
-      // TODO: this can be avoided by providing a process function with a pointer arg
-      //       this requires a more detailed result: pointer exists, alternate pointer with equal object exists, does not exist
-      KeyType* keyPtr=new KeyType();
-      *keyPtr=key;
-      res=this->insert(keyPtr);
-      if (!res.second) {
-	// this case should never occur, condition "iter!=this->end()" above would have been satisfied and 
-	// this else branch would have therefore been ignored
-	std::cerr << "ERROR: HSetMaintainer: Element was not inserted even though it could not be found in the set." << std::endl;
-	ROSE_ASSERT(0);
-	delete keyPtr;
-	keyPtr = NULL; 
-      } 
+      return std::make_pair(false,existing);
+    }
+    // converting the stack allocated object to heap allocated
+    // this copies the entire object, which is done outside of the lock
+    // TODO: this can be avoided by providing a process function with a pointer arg
+    //       this requires a more detailed result: pointer exists, alternate pointer with equal object exists, does not exist
+    KeyType* keyPtr=new KeyType();
+    *keyPtr=key;
+    omp_set_lock(&_lock);
+    std::pair<typename HSetMaintainer::iterator, bool> res=this->insert(keyPtr);
+    omp_unset_lock(&_lock);
+    if (!res.second) {
+      // another thread inserted an equal element after our lookup
+      delete keyPtr;
     }
 #ifdef HSET_MAINTAINER_DEBUG_MODE
-    std::pair<typename HSetMaintainer::iterator, bool> res1;
-    res1=this->insert(key);
-    std::pair<typename HSetMaintainer::iterator, bool> res2;
-    res2=this->insert(key);
-    if(!(res1==res2)) {
+    if(findLocked(&key)!=*res.first) {
       std::cerr<< "Error: HsetMaintainer failed:"<<std::endl;
-      std::cerr<< "res1:"<<(*res1.first).toString()<<":"<<res1.second<<std::endl;
-      std::cerr<< "res2:"<<(*res2.first).toString()<<":"<<res2.second<<std::endl;
+      std::cerr<< "res:"<<(*res.first)->toString()<<":"<<res.second<<std::endl;
       exit(1);
     }
     std::cerr << "HSET insert OK"<<std::endl;
 #endif
-    res2=std::make_pair(res.second,*res.first);
-    }
-    return res2;
+    return std::make_pair(res.second,*res.first);
   }
 
   const KeyType* processNew(KeyType& s) {
@@ -185,7 +177,14 @@ public:
     return res.second;
   }
 
-  long numberOf() { return HSetMaintainer<KeyType,HashFun,EqualToPred>::size(); }
+  // can be used while other threads are inserting elements
+  long numberOf() {
+    long num;
+    omp_set_lock(&_lock);
+    num=HSetMaintainer<KeyType,HashFun,EqualToPred>::size();
+    omp_unset_lock(&_lock);
+    return num;
+  }
 
   long maxCollisions() {
     size_t max=0;
@@ -214,8 +213,29 @@ public:
   }
 
  private:
+  std::size_t hashOf(KeyType* key) const {
+    return static_cast<std::size_t>(this->hash_function()(key));
+  }
+  typename HSetMaintainer::iterator findWithHash(KeyType* key, std::size_t hash) {
+    return this->find(key,HSetMaintainerPrecomputedHash(hash),this->key_eq());
+  }
+  const KeyType* findLocked(KeyType* key) {
+    return findLocked(key,hashOf(key));
+  }
+  const KeyType* findLocked(KeyType* key, std::size_t hash) {
+    const KeyType* ret=0;
+    omp_set_lock(&_lock);
+    typename HSetMaintainer::iterator i=findWithHash(key,hash);
+    if(i!=this->end()) {
+      ret=*i;
+    }
+    omp_unset_lock(&_lock);
+    return ret;
+  }
+
   //const KeyType* ptr(KeyType& s) {}
   bool _keepStatesDuringDeconstruction;
+  omp_lock_t _lock;
 };
 
 #endif
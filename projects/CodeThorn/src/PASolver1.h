@@ -3,7 +3,7 @@
 
 #include "Labeler.h"
 #include "CFAnalysis.h"
-#include "WorkListSeq.h"
+#include "WorkListPrio.h"
 #include "Flow.h"
 #include "Lattice.h"
 #include "PropertyState.h"
@@ -15,7 +15,7 @@ namespace CodeThorn {
 
 class PASolver1 {
  public:
-  PASolver1(WorkListSeq<Edge>& workList,
+  PASolver1(WorkListPrio<Edge>& workList,
 	   std::vector<Lattice*>& analyzerDataPreInfo,
 	   std::vector<Lattice*>& analyzerDataPostInfo,
 	   PropertyStateFactory& initialElementFactory,
@@ -25,14 +25,19 @@ class PASolver1 {
   virtual void runSolver();
   void computeCombinedPreInfo(Label lab,Lattice& inInfo);
   void computePostInfo(Label lab,Lattice& inInfo);
+  // numbers the edges of the flow in reverse postorder of their source labels and sets them as
+  // the universe of the work list (edges are processed in this order)
+  void initializeWorkList();
 
  protected:
-  WorkListSeq<Edge>& _workList;
+  WorkListPrio<Edge>& _workList;
   std::vector<Lattice*>& _analyzerDataPreInfo;
   std::vector<Lattice*>& _analyzerDataPostInfo;
   PropertyStateFactory& _initialElementFactory;
   Flow& _flow;
   DFTransferFunctions& _transferFunctions;
+  // ids of the outgoing edges in the work list, indexed by label id
+  std::vector<std::vector<size_t> > _outEdgeIds;
  public:
   void setTrace(bool trace) { _trace=trace; }
  private:
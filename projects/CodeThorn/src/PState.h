@@ -4,6 +4,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
 #include <utility>
 #include "Labeler.h"
 #include "AbstractValue.h"
@@ -32,10 +33,14 @@ namespace CodeThorn {
    */
   
   // private inharitance ensures PState is only used through methods defined here
-  class PState : private std::map<AbstractValue,CodeThorn::AbstractValue> {
+  // MS: PState is stored as a vector of (memory location,value) pairs sorted by
+  // memory location. Compared to a std::map this avoids one heap node per
+  // memory location, which dominates the memory consumption of large state spaces.
+  typedef std::vector<std::pair<AbstractValue,CodeThorn::AbstractValue> > PStateMemory;
+  class PState : private PStateMemory {
   public:
-    typedef std::map<AbstractValue,CodeThorn::AbstractValue>::const_iterator const_iterator;
-    typedef std::map<AbstractValue,CodeThorn::AbstractValue>::iterator iterator;
+    typedef PStateMemory::const_iterator const_iterator;
+    typedef PStateMemory::iterator iterator;
     friend std::ostream& operator<<(std::ostream& os, const PState& value);
     friend std::istream& operator>>(std::istream& os, PState& value);
     friend class PStateHashFun;
@@ -74,7 +79,16 @@ namespace CodeThorn {
     bool isApproximatedBy(CodeThorn::PState& other) const;
     static CodeThorn::PState combine(CodeThorn::PState& p1, CodeThorn::PState& p2);
     AbstractValueSet getVariableIds() const;
+    // hash value of the state, computed once and cached until the state is modified
+    size_t hash() const;
   private:
+    PState::iterator find(const AbstractValue& memLoc);
+    PState::const_iterator find(const AbstractValue& memLoc) const;
+    // inserts memLoc with a default value if it does not exist (as std::map::operator[])
+    AbstractValue& operator[](const AbstractValue& memLoc);
+    void invalidateHash() { _hashIsValid=false; }
+    mutable size_t _hash;
+    mutable bool _hashIsValid;
   };
   
   std::ostream& operator<<(std::ostream& os, const PState& value);
@@ -84,11 +98,7 @@ class PStateHashFun {
    public:
     PStateHashFun() {}
     long operator()(PState* s) const {
-      unsigned int hash=1;
-      for(PState::iterator i=s->begin();i!=s->end();++i) {
-        hash=((hash<<8)+((long)(*i).second.hash()))^hash;
-      }
-      return long(hash);
+      return long(s->hash());
     }
    private:
 };
@@ -100,7 +110,10 @@ class PStateEqualToPred {
       if(s1->size()!=s2->size()) {
         return false;
       } else {
-        for(PState::iterator i1=s1->begin(), i2=s2->begin();i1!=s1->end();(++i1,++i2)) {
+        // const iterators do not invalidate the cached hash values
+        const PState* c1=s1;
+        const PState* c2=s2;
+        for(PState::const_iterator i1=c1->begin(), i2=c2->begin();i1!=c1->end();(++i1,++i2)) {
           if(*i1!=*i2)
             return false;
         }
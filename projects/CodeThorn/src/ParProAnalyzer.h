@@ -46,21 +46,34 @@ namespace CodeThorn {
     void initializeSolver();
     // run the state space exploration
     void runSolver();
+    // breadth-first exploration that keeps the visited states and the frontier on disk once they exceed
+    // memoryBudget (bytes). No transition graph is built. Returns the number of reachable states.
+    size_t countReachableStatesExternally(size_t memoryBudget, std::string tmpDir="/tmp");
     void setNumberOfThreadsToUse(int n) { _numberOfThreadsToUse=n; }
     int getNumberOfThreadsToUse() { return _numberOfThreadsToUse; }
     void setAnnotationMap(EdgeAnnotationMap& emap) { _annotationToEdges = emap; }
     void setComponentApproximation(ComponentApproximation approxMode) { _approximation = approxMode; }
+    // partial-order reduction: only explores the transitions of one component in a state if they are all local
+    // (independent of all other components) and invisible (annotation not in "visibleAnnotations").
+    // The resulting STG is stutter-equivalent to the full one w.r.t. the visible annotations.
+    void setPartialOrderReduction(bool por) { _partialOrderReduction = por; }
+    void setVisibleAnnotations(std::set<std::string> visibleAnnotations) { _visibleAnnotations = visibleAnnotations; }
     std::vector<Flow*> getCfas() { return _cfas; }
     ParProTransitionGraph* getTransitionGraph() { return _transitionGraph; }
     bool isPrecise();
 
   private:
     std::list<std::pair<Edge, ParProEState> > parProTransferFunction(const ParProEState*);
+    // returns the successors of an ample set, or an empty list if no component qualifies
+    std::list<std::pair<Edge, ParProEState> > ampleSetTransferFunction(const ParProEState*);
+    bool isLocalInvisibleTransition(Edge e, unsigned int componentIndex);
     ParProEState transfer(const ParProEState* eState, Edge e);
     bool feasibleAccordingToGlobalState(Edge e, const ParProEState*);
     bool isPreciseTransition(Edge e, const ParProEState* eState);
     ParProEState setComponentToTerminationState(unsigned int i, const ParProEState* state);
     bool isIncompleteStgReady();
+    void encodeState(const ParProEState& state, std::vector<unsigned char>& record);
+    ParProEState decodeState(const unsigned char* record);
     void addToWorkList(const ParProEState* estate);
     bool isEmptyWorkList();
     const ParProEState* popWorkList();
@@ -77,6 +90,8 @@ namespace CodeThorn {
     EdgeAnnotationMap _annotationToEdges;
     ComponentApproximation _approximation;
     std::vector<Label> _artificalTerminationLabels;
+    bool _partialOrderReduction;
+    std::set<std::string> _visibleAnnotations;
   };
 
 } // end of namespace CodeThorn
@@ -48,6 +48,7 @@ namespace CodeThorn {
     // analyzes the behavior of the parallel program according to the selected options
     void explore();
     void computeStgApprox(ParallelSystem& system, ComponentApproximation approxMode);
+    size_t countReachableStatesExternally(ParallelSystem& system);
     PropertyValueTable* propertyValueTable();
 
     void setComponentSelection(ComponentSelection componentSelection) { _componentSelection = componentSelection; }
@@ -74,6 +75,12 @@ namespace CodeThorn {
     void setVisualize(bool viz) { _visualize = viz; }
     void setUseLtsMin(bool useLtsMin) { _useLtsMin = useLtsMin; }
     void setParallelCompositionOnly(bool compositionOnly) { _parallelCompositionOnly = compositionOnly; }
+    void setPartialOrderReduction(bool por) { _partialOrderReduction = por; }
+    // counts the states of the parallel composition of all components with a breadth-first exploration that keeps
+    // visited states and frontier on disk (in "tmpDir") once they exceed "budget" bytes (0: in memory, builds the STG).
+    // Only used with setParallelCompositionOnly(true).
+    void setExternalStateBudget(size_t budget) { _externalStateBudget = budget; }
+    void setExternalStateTmpDir(std::string tmpDir) { _externalStateTmpDir = tmpDir; }
 
   private:
     ParallelSystem exploreOnce();
@@ -81,6 +88,9 @@ namespace CodeThorn {
     std::set<int> randomSetNonNegativeInts(int size, int maxInt);
     void recalculateNumVerifiedFalsified();
     void addToVisOutput(ParallelSystem& system, vector<Flow*>& dotGraphs, NumberGenerator& numGen);
+    // determines whether the STGs can be reduced with respect to the analyzed LTL properties and, if so, which
+    // annotations are visible to these properties
+    bool partialOrderReductionApplicable(std::set<std::string>& visibleAnnotations);
 
     ParProLtlMiner _parProLtlMiner;
 
@@ -108,6 +118,10 @@ namespace CodeThorn {
     bool _visualize;
     bool _useLtsMin;
     bool _parallelCompositionOnly;
+    bool _partialOrderReduction;
+    std::set<std::string> _visibleAnnotations;
+    size_t _externalStateBudget;
+    std::string _externalStateTmpDir;
   };
 
 } // end of namespace CodeThorn
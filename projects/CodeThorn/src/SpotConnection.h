@@ -110,6 +110,11 @@ namespace CodeThorn {
       std::string spinSyntax(std::string ltlFormula);
       // returns a set of strings that represent the atomic propositions used in "ltlFormula"
       std::set<std::string> atomicPropositions(std::string ltlFormula);
+      // returns a set of strings that represent the atomic propositions used in any of the LTL properties
+      std::set<std::string> atomicPropositions();
+      // true if none of the LTL properties uses the next operator. Only these properties are insensitive to
+      // stuttering and can be checked on an STG that was computed with partial-order reduction.
+      bool propertiesAreNextFree();
 
     private:
       //Removes every "WU" in a string with 'W". Necessary because only accepts this syntax.
@@ -182,6 +187,8 @@ namespace CodeThorn {
       void setModeLTLDriven(bool ltlDriven);
       std::string spinSyntax(std::string ltlFormula);
       std::set<std::string> atomicPropositions(std::string ltlFormula);
+      std::set<std::string> atomicPropositions();
+      bool propertiesAreNextFree();
   private:
       void reportUndefinedFunction();
   };
@@ -0,0 +1,116 @@
+#ifndef WORKLISTPRIO_H
+#define WORKLISTPRIO_H
+
+#include <set>
+#include <map>
+#include <vector>
+#include <queue>
+#include <functional>
+
+#include "WorkList.h"
+#include "CodeThornException.h"
+
+namespace CodeThorn {
+
+  /*!
+   * \brief Work list over a fixed universe of elements that always returns the element
+   * with the highest priority (the smallest id) first. Every element is contained at
+   * most once; membership is checked in O(1) on the element id.
+   */
+  template <typename Element>
+    class WorkListPrio  {
+  public:
+    // the position of an element in "elements" is its id (and priority). Clears the work list.
+    void setElements(const std::vector<Element>& elements);
+    bool isEmpty();
+    bool exists(Element elem);
+    bool existsId(size_t id) { return inWorkList[id]; }
+    void add(Element elem);
+    void add(std::set<Element>& elemSet);
+    void addId(size_t id);
+    Element take();
+    Element examine();
+    size_t size() { return workList.size(); }
+  private:
+    size_t getId(Element elem);
+    std::vector<Element> elements;
+    std::map<Element,size_t> elementIds;
+    std::vector<bool> inWorkList;
+    std::priority_queue<size_t,std::vector<size_t>,std::greater<size_t> > workList;
+  };
+
+} // end of namespace CodeThorn
+
+namespace CodeThorn {
+// template implementation code
+template<typename Element>
+void CodeThorn::WorkListPrio<Element>::setElements(const std::vector<Element>& elems) {
+  elements=elems;
+  elementIds.clear();
+  for(size_t i=0;i<elements.size();++i) {
+    elementIds[elements[i]]=i;
+  }
+  inWorkList.assign(elements.size(),false);
+  workList=std::priority_queue<size_t,std::vector<size_t>,std::greater<size_t> >();
+}
+
+template<typename Element>
+bool CodeThorn::WorkListPrio<Element>::isEmpty() {
+  return workList.empty();
+}
+
+template<typename Element>
+size_t CodeThorn::WorkListPrio<Element>::getId(Element elem) {
+  typename std::map<Element,size_t>::iterator i=elementIds.find(elem);
+  if(i==elementIds.end()) {
+    throw CodeThorn::Exception("Error: element is not in the universe of the work list.");
+  }
+  return (*i).second;
+}
+
+template<typename Element>
+bool CodeThorn::WorkListPrio<Element>::exists(Element elem) {
+  return inWorkList[getId(elem)];
+}
+
+template<typename Element>
+void CodeThorn::WorkListPrio<Element>::add(Element elem) {
+  addId(getId(elem));
+}
+
+template<typename Element>
+void CodeThorn::WorkListPrio<Element>::add(std::set<Element>& elemSet) {
+  for(typename std::set<Element>::iterator i=elemSet.begin();i!=elemSet.end();++i) {
+    add(*i);
+  }
+}
+
+template<typename Element>
+void CodeThorn::WorkListPrio<Element>::addId(size_t id) {
+  if(!inWorkList[id]) {
+    inWorkList[id]=true;
+    workList.push(id);
+  }
+}
+
+template<typename Element>
+Element CodeThorn::WorkListPrio<Element>::take() {
+  if(workList.empty()) {
+    throw CodeThorn::Exception("Error: attempted to take element from empty work list.");
+  }
+  size_t id=workList.top();
+  workList.pop();
+  inWorkList[id]=false;
+  return elements[id];
+}
+
+template<typename Element>
+Element CodeThorn::WorkListPrio<Element>::examine() {
+  if(workList.empty())
+    throw CodeThorn::Exception("Error: attempted to examine next element in empty work list.");
+  return elements[workList.top()];
+}
+
+}
+
+#endif
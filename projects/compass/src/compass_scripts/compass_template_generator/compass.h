@@ -83,6 +83,12 @@ namespace Compass {
   //! Flymake mode for use of Compass with Emacs
   extern bool UseFlymake;
 
+  //! Run the checkers that support it in a single fused traversal of the AST
+  extern bool fuseCheckers;
+
+  //! Directory of the per translation unit result cache (--compass:cache <dir>); no cache is used if empty
+  extern std::string resultCacheDir;
+
   //! Support for ToolGear XML viewer for output data when run as batch
   extern bool UseToolGear;
   extern std::string tguiXML;
@@ -149,6 +155,8 @@ namespace Compass {
     /// Get the value of a parameter
     std::string operator[](const std::string& name) const
       throw (ParameterNotFoundException);
+    /// Get all parameters
+    const std::map<std::string, std::string>& getParameterMap() const { return data; }
   };
 
   std::string findParameterFile();
@@ -277,6 +285,13 @@ namespace Compass {
     virtual ~AstSimpleProcessingWithRunFunction() {}
     virtual void run(SgNode*)=0;
     virtual void visit(SgNode* n)=0;
+    /// Checkers whose run() does nothing but traverse the given node with
+    /// visit() return true and set the order of that traversal.  Such
+    /// checkers can be fused into a single traversal (see runFusedCheckers).
+    virtual bool getFusedTraversalOrder(t_traverseOrder& order) const { return false; }
+    /// The node variants visit() reports on; a fused traversal dispatches
+    /// only these variants to the checker.  Empty means all variants.
+    virtual VariantVector getVisitedVariants() const { return VariantVector(); }
   };
 
 
@@ -372,6 +387,52 @@ namespace Compass {
 
   /// Run a checker and its prerequisites
   void runCheckerAndPrereqs(const Checker* checker, SgProject* proj, Parameters params, OutputObject* output);
+
+  /// Run all checkers that support it in one traversal of the project; each
+  /// node is dispatched only to the checkers interested in its variant.  The
+  /// prerequisites must have been run already.  A checker that throws is
+  /// disabled for the rest of the traversal and reported in errors.  Returns
+  /// the checkers that cannot be fused and have to be run separately.
+  std::vector<const Checker*> runFusedCheckers(const std::vector<const Checker*>& checkers, SgProject* proj, Parameters params, OutputObject* output, std::vector<std::pair<std::string, std::string> >& errors);
+
+  /// A cache of the violations reported for each translation unit.  An
+  /// entry is keyed on a hash of the absolute name of the file, its
+  /// preprocessed output (including the line markers, so that the positions
+  /// in the cached messages are still right), the names of the checkers, the
+  /// parameters and the other command line options, so a file with an entry
+  /// need not be checked again.  Only the printed messages are cached (they
+  /// are replayed without an AST), and the cache relies on the checkers
+  /// reporting violations per translation unit.
+  class ResultCache {
+  public:
+    ResultCache(const std::string& directory);
+    bool isEnabled() const { return !directory.empty(); }
+    /// Set the checkers and parameters that are part of every key
+    void setConfiguration(const std::vector<const Checker*>& checkers, const Parameters& params);
+    /// Look up the source files on the command line.  Returns the number of
+    /// source files that have no entry and have to be checked.
+    size_t lookup(const Rose_STL_Container<std::string>& commandLineArray);
+    /// Print the cached violations of the source files that have an entry
+    void replay(std::ostream& stream) const;
+    /// Remove the source files that have an entry from the command line, so
+    /// that they are not even parsed (and not compiled either)
+    void removeCachedFiles(Rose_STL_Container<std::string>& commandLineArray) const;
+    /// Store the violations reported for the checked source files of the
+    /// project; nothing is stored if a violation cannot be attributed to a
+    /// source file.
+    void store(SgProject* project, const std::vector<OutputViolationBase*>& violations) const;
+
+  private:
+    bool computeKey(const std::string& sourceFile, const std::vector<std::string>& options, std::string& key) const;
+    std::string entryFileName(const std::string& key) const;
+
+    std::string directory;
+    std::string configuration;
+    // keys of the source files on the command line, by absolute file name
+    std::map<std::string, std::string> keys;
+    // cached messages of the source files that have an entry, by name on the command line
+    std::map<std::string, std::vector<std::string> > cachedMessages;
+  };
 }
 
 #endif // ROSE_COMPASS_H
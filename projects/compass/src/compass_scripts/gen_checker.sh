@@ -251,6 +251,10 @@ namespace CompassAnalyses
                  // void run(SgNode* n){ this->traverse(n, initialInheritedAttribute()); }
                     void run(SgNode* n){ this->traverse(n, preorder); }
 
+                 // As long as run only traverses n, the checker can share a single traversal
+                 // with other checkers (--compass:fuse). Remove this if run does anything else.
+                    bool getFusedTraversalOrder(t_traverseOrder& order) const { order = preorder; return true; }
+
                  // Change this function if you are using a different type of traversal, e.g.
                  // void *evaluateInheritedAttribute(SgNode *, void *);
                  // for AstTopDownProcessing.
@@ -0,0 +1,47 @@
+#!/bin/sh
+# Tests the Compass result cache (--compass:cache).  A second run replays the violations of the
+# first one, a run after adding a line to the file reports the new positions, and the object file
+# is still produced when the violations of every file come from the cache.
+#
+# usage: testResultCache.sh COMPASS_MAIN SOURCE_FILE [COMPASS_OPTIONS...]
+set -e
+compass="$1"
+source="$2"
+shift 2
+
+work=resultCache.work
+rm -rf $work
+mkdir $work
+cp "$source" $work/input.C
+
+# Prints the sorted violations reported for the copy of the source file; the arguments are
+# passed to compass in addition to the options given on the command line.
+violations() {
+    "$compass" "$@" 2>&1 >/dev/null | grep 'input\.C:' | sort
+}
+
+fail() {
+    echo "testResultCache.sh: $1" >&2
+    exit 1
+}
+
+first=$(violations --compass:cache $work/cache "$@" -rose:skipfinalCompileStep -c $work/input.C)
+[ -n "$first" ] || fail "no violations reported"
+ls $work/cache/*.violations >/dev/null 2>&1 || fail "no cache entry written"
+
+second=$(violations --compass:cache $work/cache "$@" -rose:skipfinalCompileStep -c $work/input.C)
+[ "$second" = "$first" ] || fail "replayed violations differ from the checked ones"
+
+# Moving the code down by one line must change the reported positions
+{ echo "// added line"; cat "$source"; } >$work/input.C
+moved=$(violations --compass:cache $work/cache "$@" -rose:skipfinalCompileStep -c $work/input.C)
+[ "$moved" != "$first" ] || fail "positions did not change after adding a line"
+uncached=$(violations "$@" -rose:skipfinalCompileStep -c $work/input.C)
+[ "$moved" = "$uncached" ] || fail "violations differ from a run without the cache"
+
+# Every file is cached now, but the object file must still be produced
+cached=$(violations --compass:cache $work/cache "$@" -c $work/input.C -o $work/input.o)
+[ "$cached" = "$moved" ] || fail "replayed violations differ when compiling"
+[ -f $work/input.o ] || fail "no object file produced"
+
+rm -rf $work
@@ -153,6 +153,19 @@ class NameQualificationTraversal : public AstTopDownBottomUpProcessing<NameQuali
        // of types to support name qualification for SgPointerMemberType).
           SgStatement* explictlySpecifiedCurrentStatement;
 
+       // Memo of setNameQualificationSupport() results keyed on the scope and the requested qualification length.
+       // The same qualifier (e.g. "::std::") is rebuilt for every reference to a declaration in that scope, so it
+       // is computed once per traversal.  Only qualifiers built from non-template scopes are recorded since the
+       // template argument strings can depend on name qualification that is computed later in the traversal.
+          struct QualifierCacheEntry
+             {
+               std::string qualifierString;
+               int amountOfNameQualificationRequired;
+               bool globalQualification;
+               bool typeEvaluation;
+             };
+          std::map<std::pair<SgScopeStatement*,int>,QualifierCacheEntry> qualifierCache;
+
      public:
        // DQ (3/24/2016): Adding Robb's meageage mechanism (data member and function).
           static Sawyer::Message::Facility mlog;
@@ -368,6 +368,8 @@ CommandlineProcessing::isOptionTakingSecondParameter( string argument )
        // DQ (9/19/2010): UPC support for upc_threads to define the "THREADS" variable.
           argument == "-rose:upc_threads" ||
 
+          argument == "-rose:backend_jobs" ||               // Number of backend compiler processes run concurrently
+
        // DQ (9/26/2011): Added support for detection of dangling pointers within translators built using ROSE.
           argument == "-rose:detect_dangling_pointers" ||   // Used to specify level of debugging support for optional detection of dangling pointers 
 
@@ -801,6 +803,21 @@ SgProject::processCommandLine(const vector<string>& input_argv)
 
      Rose::Cmdline::ProcessKeepGoing(this, local_commandLineArgumentList);
 
+     int integerOptionForBackendJobs = 0;
+     if ( CommandlineProcessing::isOptionWithParameter(local_commandLineArgumentList,"-rose:","(backend_jobs)",integerOptionForBackendJobs,true) == true )
+        {
+          if (integerOptionForBackendJobs < 1)
+             {
+               printf ("Error: -rose:backend_jobs requires a positive number of jobs (found %d) \n",integerOptionForBackendJobs);
+               ROSE_ASSERT(false);
+             }
+
+          set_backendCompilerJobs(integerOptionForBackendJobs);
+
+          if ( SgProject::get_verbose() >= 1 )
+               printf ("backend compiler jobs = %d \n",integerOptionForBackendJobs);
+        }
+
   //
   // Standard compiler options (allows specification of language -x option to just run compiler without /dev/null as input file)
   //
@@ -3120,6 +3137,10 @@ SgFile::usage ( int status )
 "                             try to compile as much as possible, ignoring failures,\n"
 "                             in order to gauage the overall status of your translator,\n"
 "                             with respect to that application.\n"
+"     -rose:backend_jobs n\n"
+"                             Run up to n backend compiler processes at once when\n"
+"                             several source files are given on the command line\n"
+"                             (similar to GNU Make's --jobs option; default 1).\n"
 "\n"
 "Operation modifiers:\n"
 "     -rose:output_warnings   compile with warnings mode on\n"
@@ -5331,6 +5352,7 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
      int integerOption = 0;
      optionCount = sla(argv, "-rose:", "($)^", "(v|verbose)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)^", "(upc_threads)", &integerOption, 1);
+     optionCount = sla(argv, "-rose:", "($)^", "(backend_jobs)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)", "(C|C_only)",1);
      optionCount = sla(argv, "-rose:", "($)", "(UPC|UPC_only)",1);
      optionCount = sla(argv, "-rose:", "($)", "(OpenMP|openmp)",1);
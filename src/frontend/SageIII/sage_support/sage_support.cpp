@@ -29,6 +29,12 @@
 
 #include <algorithm>
 
+#ifndef _MSC_VER
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include <boost/algorithm/string/join.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/foreach.hpp>
@@ -6653,6 +6659,119 @@ Rose::Backend::Java::CreateDestdir(SgProject* project)
   return destdir;
 }
 
+#ifndef _MSC_VER
+// Compiles the unparsed files of a multi-file project with up to "numberOfJobs" backend compiler
+// invocations running at once (the equivalent of "make -j").  Each file is compiled by
+// SgFile::compileOutput() in a forked child process; the child only reads the AST (building the
+// compiler command line) and the generated object files are written to disk, so nothing needs
+// to be communicated back except the exit status.  The link step that follows is unchanged.
+// The parent blocks in waitpid() for any child and looks the returned process up in the job
+// table.  If a process cannot be created, no further files are started and -1 is returned once
+// the running jobs have finished.
+static int
+compileOutputOfFilesInParallel ( SgProject* project, int numberOfJobs )
+   {
+     ROSE_ASSERT(project != NULL);
+     ROSE_ASSERT(numberOfJobs > 1);
+
+     int errorCode = 0;
+     int numberOfFiles = project->numberOfFiles();
+     int nextFile = 0;
+     bool startFailed = false;
+     std::map<pid_t,SgFile*> runningJobs;
+
+     while ((startFailed == false && nextFile < numberOfFiles) || runningJobs.empty() == false)
+        {
+          if (startFailed == false && nextFile < numberOfFiles && (int)runningJobs.size() < numberOfJobs)
+             {
+               SgFile & file = project->get_file(nextFile);
+
+            // Buffered output would otherwise be written by both the parent and the child.
+               std::cout.flush();
+               fflush(NULL);
+
+               pid_t pid = fork();
+               if (pid == -1)
+                  {
+                    perror("fork: error in compileOutputOfFilesInParallel ");
+                    startFailed = true;
+                    errorCode = -1;
+                    continue;
+                  }
+
+               nextFile++;
+               file.set_compileOnly(true);
+               file.set_multifile_support(true);
+
+               if (pid == 0)
+                  {
+                 // Use _exit() so that the child does not run the parent's atexit handlers and static destructors.
+                    int localErrorCode = file.compileOutput(0);
+                    std::cout.flush();
+                    fflush(NULL);
+                    _exit(localErrorCode == 0 ? 0 : 1);
+                  }
+
+               if ( SgProject::get_verbose() > 0 )
+                    printf ("In compileOutputOfFilesInParallel(): started backend compiler job %d for %s \n",(int)pid,file.getFileName().c_str());
+
+               runningJobs[pid] = &file;
+               continue;
+             }
+
+       // Block until any child exits.  A child that is not one of our jobs was started by the translator and
+       // finished during the backend compilation; its status is discarded.
+          int status = 0;
+          pid_t pid;
+          while ((pid = waitpid(-1, &status, 0)) == -1 && errno == EINTR)
+             {
+             }
+
+          if (pid == -1)
+             {
+            // No children left to wait for (ECHILD): the remaining jobs cannot be waited for and count as failed.
+               perror("waitpid: error in compileOutputOfFilesInParallel ");
+               for (std::map<pid_t,SgFile*>::iterator job = runningJobs.begin(); job != runningJobs.end(); ++job)
+                  {
+                    job->second->set_compileOnly(false);
+                    job->second->set_backendCompilerErrorCode(-1);
+                    printf ("Error: backend compilation failed for file = %s \n",job->second->getFileName().c_str());
+                  }
+               runningJobs.clear();
+               if (errorCode >= 0)
+                  {
+                    errorCode = 1;
+                  }
+               continue;
+             }
+
+          std::map<pid_t,SgFile*>::iterator job = runningJobs.find(pid);
+          if (job == runningJobs.end())
+             {
+               continue;
+             }
+
+          SgFile* file = job->second;
+          runningJobs.erase(job);
+          file->set_compileOnly(false);
+
+          int localErrorCode = (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : 1;
+          if (localErrorCode != 0)
+             {
+               file->set_backendCompilerErrorCode(-1);
+               printf ("Error: backend compilation failed for file = %s \n",file->getFileName().c_str());
+             }
+
+          if (errorCode >= 0 && localErrorCode > errorCode)
+             {
+               errorCode = localErrorCode;
+             }
+        }
+
+     return errorCode;
+   }
+#endif
+
 //! project level compilation and linking
 // three cases: 1. preprocessing only
 //              2. compilation:
@@ -6886,6 +7005,15 @@ SgProject::compileOutput()
                     multifile_support_compile_only_flag = true;
                   }
 
+#ifndef _MSC_VER
+            // Run the backend compiler on several files at once when requested (-rose:backend_jobs n).  This is
+            // not used with -rose:keep_going, since that mode retries failed files in-process with the original source.
+               if (multifile_support_compile_only_flag == true && get_backendCompilerJobs() > 1 && get_keep_going() == false)
+                  {
+                    errorCode = compileOutputOfFilesInParallel(this, get_backendCompilerJobs());
+                  }
+                 else
+#endif
                for (i=0; i < numberOfFiles(); i++)
                   {
                     int localErrorCode = 0;
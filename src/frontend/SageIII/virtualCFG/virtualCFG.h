@@ -17,6 +17,7 @@ class SgInitializedName;
 class SgLabelSymbol;
 class SgLabelRefExp;
 class SgStatement;
+class SgFunctionDefinition;
 
 #ifndef _MSC_VER
 SgStatement* isSgStatement(SgNode* node);
@@ -331,6 +332,25 @@ extern int efgh;
   template <class Node1T, class Node2T, class EdgeT>
   void makeEdge(Node1T from, Node2T to, std::vector<EdgeT>& result);
 
+  //! Build a materialized copy of the CFG of a function (edges stored in compressed
+  //! sparse row form in an AST attribute on the function definition).  Once built,
+  //! CFGNode::outEdges() and CFGNode::inEdges() answer from the stored edges instead of
+  //! regenerating them from the AST.  This is optional and intended for analyses that
+  //! query the same edges many times (dataflow, StaticCFG, filtered CFGs).  The CFG is
+  //! discarded when a node of the function is modified (see noteModification()); changes
+  //! to other functions do not affect it.  Thread safe.
+  ROSE_DLL_API void materializeCFG(SgFunctionDefinition* func);
+
+  //! Discard the materialized CFG of a function.  Thread safe.
+  ROSE_DLL_API void invalidateMaterializedCFG(SgFunctionDefinition* func);
+
+  //! \internal Called by SgNode::set_isModified() and SgNode::set_parent() with a modified
+  //! node; marks the materialized CFGs of the functions containing it as stale.
+  ROSE_DLL_API void noteModification(SgNode* node);
+
+  //! Test whether the CFG of a function is currently materialized and up to date
+  ROSE_DLL_API bool hasMaterializedCFG(SgFunctionDefinition* func);
+
 } // end namespace VirtualCFG
 
 #define SGFUNCTIONCALLEXP_INTERPROCEDURAL_INDEX 2
@@ -12,6 +12,7 @@
 #include "RoseAst.h"
 #include <list>
 #include <set>
+#include <map>
 
 class SgNode;
 
@@ -45,11 +46,14 @@ class AstMatching {
   void performMatchingOnAst(SgNode* root);
   void performMatching();
   void generateMatchOperationsSequence();
+  void determineRootCheckNode();
 
  private:
   std::string _matchExpression;
   SgNode* _root;
   MatchOperationList* _matchOperationsSequence;
+  // type check of the pattern's root node (0 if the pattern does not start with a fixed node type)
+  MatchOpCheckNode* _rootCheckNode;
   MatchStatus _status;
   bool _keepMarkedLocations;
 };
@@ -101,6 +101,8 @@ class MatchOpCheckNode : public MatchOperation {
   MatchOpCheckNode(std::string nodename);
   std::string toString();
   bool performOperation(MatchStatus&  status, RoseAst::iterator& i, SingleMatchResult& vb);
+  // checks the node type without allocating a temporary string (also used as pre-filter by AstMatching)
+  bool matchesNode(SgNode* node) const;
  private:
   std::string _nodename;
 };
@@ -4,8 +4,12 @@
 #include "rosedll.h"
 #include "rose_override.h"
 #include <Sawyer/Attribute.h>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/unordered_map.hpp>
 #include <list>
 #include <set>
+#include <vector>
 
 class SgNode;
 class SgNamedType;
@@ -403,6 +407,196 @@ private:
 
 
 
+/** Dense numbering of IR nodes for side-table attributes.
+ *
+ *  Each node that is inserted into the index is assigned a slot consisting of its IR node class (the node's @c VariantT) and
+ *  an index that is dense within that class, i.e., the first node of class @c SgIfStmt gets index zero, the second gets
+ *  index one, etc.  Side tables (@ref AstAttributeTable) use the slot to address contiguous per-class value arrays.
+ *
+ *  A node keeps its slot until it is erased from the index or deleted. Deleting a node erases it from every index (the
+ *  generated @c SgNode destructor calls @ref nodeDeleted), so a new node allocated at the same address gets a new slot
+ *  instead of inheriting the deleted node's values.
+ *
+ *  Indexes and side tables are not thread safe. */
+class ROSE_DLL_API AstNodeIndex {
+public:
+    /** Location of a node's values in a side table. */
+    struct Slot {
+        unsigned variant;                               /**< IR node class, the node's @c VariantT. */
+        size_t index;                                   /**< Dense index within the IR node class. */
+        Slot(): variant(0), index(0) {}
+        Slot(unsigned variant, size_t index): variant(variant), index(index) {}
+    };
+
+private:
+    boost::unordered_map<const SgNode*, Slot> slots_;
+    std::vector<size_t> classSizes_;                    // number of slots assigned per IR node class
+
+    // Not copyable since indexes are registered by address for nodeDeleted
+    AstNodeIndex(const AstNodeIndex&);
+    AstNodeIndex& operator=(const AstNodeIndex&);
+
+public:
+    /** Construct an empty index. */
+    AstNodeIndex();
+
+    ~AstNodeIndex();
+
+    /** Index shared by all side tables that don't specify their own. */
+    static AstNodeIndex& instance();
+
+    /** Erase a node that is being deleted from all indexes.
+     *
+     *  This is called by the @c SgNode destructor and returns immediately if no index has any nodes. */
+    static void nodeDeleted(const SgNode *node);
+
+    /** Slot of a node, assigning a new slot if the node has none yet. */
+    Slot insert(const SgNode *node);
+
+    /** Slot of a node if it has one.
+     *
+     *  Returns true and sets @p slot if the node is in the index, returns false otherwise. Does not allocate. */
+    bool find(const SgNode *node, Slot &slot /*out*/) const {
+        boost::unordered_map<const SgNode*, Slot>::const_iterator found = slots_.find(node);
+        if (found == slots_.end())
+            return false;
+        slot = found->second;
+        return true;
+    }
+
+    /** Remove a node from the index.
+     *
+     *  The node's slot is not reused. Values stored for the node in side tables become unreachable. */
+    void erase(const SgNode *node);
+
+    /** Number of slots assigned for an IR node class. */
+    size_t classSize(unsigned variant) const {
+        return variant < classSizes_.size() ? classSizes_[variant] : 0;
+    }
+
+    /** Number of nodes in the index. */
+    size_t size() const {
+        return slots_.size();
+    }
+};
+
+/** Side table storing one typed attribute for many IR nodes.
+ *
+ *  An @ref AstAttributeMechanism stores heap-allocated polymorphic @ref AstAttribute objects in a per-node container, which
+ *  costs an allocation, a container lookup and a virtual object for every annotated node. Analyses that attach a small value
+ *  to every node can use a side table instead: the values of type @p T are stored by value in contiguous per-class arrays
+ *  addressed by the node's @ref AstNodeIndex slot.  Once a node is numbered and the table has grown to hold it, @ref get and
+ *  @ref set are constant time and do not allocate.
+ *
+ *  The attribute name is declared as a Sawyer attribute ID like the names used by @ref AstAttributeMechanism, but the
+ *  values are stored separately: a side table and a per-node attribute with the same name do not see each other's values.
+ *  The per-node attribute API is not affected by side tables.
+ *
+ *  Since values are returned by reference, @p T cannot be @c bool; use @c char or an enum instead. */
+template<class T>
+class AstAttributeTable {
+    BOOST_STATIC_ASSERT(!(boost::is_same<T, bool>::value));
+public:
+    /** Type of values stored in this table. */
+    typedef T Value;
+
+private:
+    Sawyer::Attribute::Id id_;
+    AstNodeIndex *index_;
+    T defaultValue_;
+    std::vector<std::vector<T> > values_;               // indexed by variant and slot index
+    std::vector<std::vector<bool> > present_;           // whether a value was set for the slot
+    size_t nValues_;
+
+public:
+    /** Construct a table for the named attribute.
+     *
+     *  Nodes for which no value has been set have the specified default value. */
+    explicit AstAttributeTable(const std::string &name, const T &defaultValue = T(),
+                               AstNodeIndex &index = AstNodeIndex::instance())
+        : id_(Sawyer::Attribute::id(name)), index_(&index), defaultValue_(defaultValue), nValues_(0) {
+        if (Sawyer::Attribute::INVALID_ID == id_)
+            id_ = Sawyer::Attribute::declare(name);
+    }
+
+    /** Attribute ID of this table. */
+    Sawyer::Attribute::Id id() const {
+        return id_;
+    }
+
+    /** Attribute name of this table. */
+    const std::string& name() const {
+        return Sawyer::Attribute::name(id_);
+    }
+
+    /** Test whether a value was set for a node. */
+    bool exists(const SgNode *node) const {
+        AstNodeIndex::Slot slot;
+        return index_->find(node, slot) && isPresent(slot);
+    }
+
+    /** Value stored for a node, or the default value if none is stored. */
+    const T& get(const SgNode *node) const {
+        AstNodeIndex::Slot slot;
+        if (index_->find(node, slot) && isPresent(slot))
+            return values_[slot.variant][slot.index];
+        return defaultValue_;
+    }
+
+    /** Store a value for a node, replacing any previous value. */
+    void set(const SgNode *node, const T &value) {
+        AstNodeIndex::Slot slot = index_->insert(node);
+        if (slot.variant >= values_.size()) {
+            values_.resize(slot.variant + 1);
+            present_.resize(slot.variant + 1);
+        }
+        if (slot.index >= values_[slot.variant].size()) {
+            // grow to the current class size so that numbering many nodes doesn't resize once per node
+            size_t n = index_->classSize(slot.variant);
+            values_[slot.variant].resize(n, defaultValue_);
+            present_[slot.variant].resize(n, false);
+        }
+        values_[slot.variant][slot.index] = value;
+        if (!present_[slot.variant][slot.index]) {
+            present_[slot.variant][slot.index] = true;
+            ++nValues_;
+        }
+    }
+
+    /** Remove the value stored for a node, if any. */
+    void remove(const SgNode *node) {
+        AstNodeIndex::Slot slot;
+        if (index_->find(node, slot) && isPresent(slot)) {
+            values_[slot.variant][slot.index] = defaultValue_;
+            present_[slot.variant][slot.index] = false;
+            --nValues_;
+        }
+    }
+
+    /** Number of values stored.
+     *
+     *  Values stored for nodes that were later erased from the index, including deleted nodes, are counted until the table is
+     *  cleared. */
+    size_t size() const {
+        return nValues_;
+    }
+
+    /** Remove all values. */
+    void clear() {
+        values_.clear();
+        present_.clear();
+        nValues_ = 0;
+    }
+
+private:
+    bool isPresent(const AstNodeIndex::Slot &slot) const {
+        return slot.variant < present_.size() && slot.index < present_[slot.variant].size() &&
+            present_[slot.variant][slot.index];
+    }
+};
+
+
+
 /** Attribute corresponding to a metric.
  *
  *  A metric attribute represents a numeric value obtained by either dynamic analysis (gprof or hpct) or static analysis (for
@@ -29,6 +29,21 @@ private:
 
     SgIncidenceDirectedGraph* classGraph;
 
+public:
+
+    /** Functions that may be called by a polymorphic call of a member function through a class, keyed on the class
+     * and the called member function declaration. */
+    typedef std::map<std::pair<SgClassDefinition*, SgMemberFunctionDeclaration*>, std::vector<SgFunctionDeclaration*> >
+        VirtualCallTargetMap;
+
+private:
+
+    /** Results of CallTargetSet::solveMemberFunctionCall() for polymorphic calls, so that the subclasses are only searched
+     * once per (class, member function) rather than once per call site. The first map excludes pure virtual functions, the
+     * second includes them. Both are only valid for the hierarchy this object was built from. */
+    VirtualCallTargetMap virtualCallTargets;
+    VirtualCallTargetMap virtualCallTargetsWithPureVirtual;
+
 public:
 
     ClassHierarchyWrapper(SgNode *node);
@@ -36,6 +51,10 @@ public:
     const ClassDefSet& getDirectSubclasses(SgClassDefinition *) const;
     const ClassDefSet& getAncestorClasses(SgClassDefinition *) const;
 
+    /** Cache of resolved polymorphic call targets (see CallTargetSet::solveMemberFunctionCall). */
+    VirtualCallTargetMap& getVirtualCallTargetCache(bool includePureVirtualFunc)
+       { return includePureVirtualFunc ? virtualCallTargetsWithPureVirtual : virtualCallTargets; }
+
 private:
 
     /** Computes the transitive closure of the child-parent class relationship.
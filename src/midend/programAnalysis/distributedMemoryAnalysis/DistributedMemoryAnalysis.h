@@ -5,12 +5,15 @@
 #ifndef DISTRIBUTED_MEMORY_ANALYSIS_H
 #define DISTRIBUTED_MEMORY_ANALYSIS_H
 
+#include <utility>
+#include <vector>
+
+// The pre- and post-traversals below are shared with the MPI-free MultiProcessTraversal
+// (see MultiProcessAnalysis.h); only the MPI-based classes require ROSE_MPI.
 #if ROSE_MPI
 
 //#include <mpi.h>
 
-#include <utility>
-
 void initializeDistributedMemoryProcessing(int *argc, char ***argv);
 void finalizeDistributedMemoryProcessing();
 
@@ -92,6 +95,8 @@ private:
 
 
 
+#endif
+
 // --------- Implementor Line - Do Not Cross ---------
 // There is nothing for users to see here, move along.
 
@@ -174,5 +179,3 @@ private:
 #include "DistributedMemoryAnalysisImplementation.h"
 
 #endif
-
-#endif
@@ -24,6 +24,8 @@
 #define RUN_DECLARATION false
 #define ALLGATHER_MPI false
 
+#if ROSE_MPI
+
 // --------------------------------------------------------------------------
 // class DistributedMemoryAnalysisBase -- version by Gergo (based on nodes weight)
 // --------------------------------------------------------------------------
@@ -509,6 +511,8 @@ performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
       delete[] myBuffer;
 }
 
+#endif
+
 
 
 
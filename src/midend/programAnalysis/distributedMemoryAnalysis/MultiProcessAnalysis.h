@@ -0,0 +1,64 @@
+// Process-parallel variant of the distributed memory traversal framework that runs on a single machine without MPI.
+// The functions of the AST are partitioned across worker processes forked from the analysis process; each worker
+// analyzes its functions on its (copy-on-write) copy of the AST and sends the serialized results back through a pipe.
+// This makes it possible to use all cores for analyses that are not thread-safe.
+
+#ifndef MULTI_PROCESS_ANALYSIS_H
+#define MULTI_PROCESS_ANALYSIS_H
+
+#include <utility>
+#include <vector>
+
+#include "DistributedMemoryAnalysis.h"
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+class MultiProcessTraversal
+{
+public:
+    // numberOfProcesses == 0 selects the number of online processors
+    MultiProcessTraversal(int numberOfProcesses = 0);
+    virtual ~MultiProcessTraversal() {}
+
+    void performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                         AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                         AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal);
+    SynthesizedAttributeType getFinalResults() {return finalResults;}
+
+    // ID of the worker process running analyzeSubtree (0 .. numberOfProcesses()-1); -1 in the parent process,
+    // also while it analyzes functions itself (single process, failed fork or failed worker)
+    int myID() const { return my_id; }
+    int numberOfProcesses() const { return processes; }
+    bool isRootProcess() const { return my_id == -1; }
+
+protected:
+    // Same interface as DistributedMemoryTraversal, so analyses can be used with both drivers.
+    virtual SynthesizedAttributeType analyzeSubtree(SgFunctionDeclaration *funcDecl,
+                                                    InheritedAttributeType initialInheritedValue) = 0;
+    virtual std::pair<int, void *> serializeAttribute(SynthesizedAttributeType attribute) const = 0;
+    virtual SynthesizedAttributeType deserializeAttribute(std::pair<int, void *> serializedAttribute) const = 0;
+    virtual void deleteSerializedAttribute(std::pair<int, void *> serializedAttribute) const {}
+
+private:
+    int my_id;
+    int processes;
+    SynthesizedAttributeType finalResults;
+
+    std::vector<SgFunctionDeclaration *> funcDecls;
+    std::vector<InheritedAttributeType> initialInheritedValues;
+
+    // assigns each function (by index into funcDecls) to a worker, balancing the weights computed by the pre-traversal
+    void assignFunctions(const std::vector<size_t> &nodeCounts, const std::vector<size_t> &funcWeights,
+                         std::vector<std::vector<size_t> > &functionsOfWorker) const;
+    // runs in the forked worker: analyzes the given functions and writes the results to fd
+    void runWorker(int worker, const std::vector<size_t> &functions, int fd);
+    // runs in the parent: reads the results of all workers; haveResult is false for functions no worker delivered
+    void collectResults(const std::vector<int> &fds, std::vector<std::vector<unsigned char> > &results,
+                        std::vector<bool> &haveResult) const;
+
+    MultiProcessTraversal(const MultiProcessTraversal &);
+    const MultiProcessTraversal &operator=(const MultiProcessTraversal &);
+};
+
+#include "MultiProcessAnalysisImplementation.h"
+
+#endif
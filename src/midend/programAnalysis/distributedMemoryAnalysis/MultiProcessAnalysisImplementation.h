@@ -0,0 +1,302 @@
+// Process-parallel traversal implementation.
+
+#ifndef MULTI_PROCESS_ANALYSIS_IMPLEMENTATION_H
+#define MULTI_PROCESS_ANALYSIS_IMPLEMENTATION_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace MultiProcessAnalysisSupport
+{
+  // Each result is sent as a record header followed by the serialized attribute.
+  struct RecordHeader
+  {
+    int functionIndex;
+    int size;
+  };
+
+  inline bool writeAll(int fd, const void *buffer, size_t size)
+  {
+    const unsigned char *p = (const unsigned char *) buffer;
+    while (size > 0)
+    {
+        ssize_t written = write(fd, p, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        p += written;
+        size -= written;
+    }
+    return true;
+  }
+
+  struct SortByWeightDescending
+  {
+    const std::vector<double> &weights;
+    SortByWeightDescending(const std::vector<double> &weights) : weights(weights) {}
+    bool operator()(size_t a, size_t b) const { return weights[a] > weights[b]; }
+  };
+}
+
+// --------------------------------------------------------------------------
+// class MultiProcessTraversal
+// --------------------------------------------------------------------------
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+MultiProcessTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+MultiProcessTraversal(int numberOfProcesses)
+  : my_id(-1), processes(numberOfProcesses)
+{
+    if (processes <= 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        processes = online > 0 ? (int) online : 1;
+    }
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+MultiProcessTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+assignFunctions(const std::vector<size_t> &nodeCounts, const std::vector<size_t> &funcWeights,
+                std::vector<std::vector<size_t> > &functionsOfWorker) const
+{
+ // Same weight as in DistributedMemoryAnalysisBase::computeFunctionIndicesPerNode: the heaviest
+ // functions are assigned first, each one to the worker with the least weight so far.
+    size_t functions = nodeCounts.size();
+    std::vector<double> weights(functions);
+    std::vector<size_t> order(functions);
+    for (size_t i = 0; i < functions; i++)
+    {
+        weights[i] = (double) nodeCounts[i] * funcWeights[i];
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), MultiProcessAnalysisSupport::SortByWeightDescending(weights));
+
+    std::vector<double> workerWeight(functionsOfWorker.size(), 0.0);
+    for (size_t k = 0; k < functions; k++)
+    {
+        size_t min_worker = std::min_element(workerWeight.begin(), workerWeight.end()) - workerWeight.begin();
+        workerWeight[min_worker] += weights[order[k]];
+        functionsOfWorker[min_worker].push_back(order[k]);
+    }
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+MultiProcessTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+runWorker(int worker, const std::vector<size_t> &functions, int fd)
+{
+    my_id = worker;
+    bool ok = true;
+
+ // An exception must not unwind into the parent's code in the worker: the results written so far
+ // are kept and the remaining functions are analyzed again by the parent.
+    try
+    {
+        for (size_t k = 0; ok && k < functions.size(); k++)
+        {
+            size_t i = functions[k];
+            SynthesizedAttributeType result = analyzeSubtree(funcDecls[i], initialInheritedValues[i]);
+            std::pair<int, void *> serialized = serializeAttribute(result);
+            MultiProcessAnalysisSupport::RecordHeader header;
+            header.functionIndex = (int) i;
+            header.size = serialized.first;
+            ok = MultiProcessAnalysisSupport::writeAll(fd, &header, sizeof header)
+              && MultiProcessAnalysisSupport::writeAll(fd, serialized.second, serialized.first);
+            deleteSerializedAttribute(serialized);
+        }
+    }
+    catch (...)
+    {
+        ok = false;
+    }
+    close(fd);
+
+ // Do not run destructors or atexit handlers of the parent's state in the worker.
+    std::cout.flush();
+    std::cerr.flush();
+    _exit(ok ? 0 : 1);
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+MultiProcessTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+collectResults(const std::vector<int> &fds, std::vector<std::vector<unsigned char> > &results,
+               std::vector<bool> &haveResult) const
+{
+ // Read all pipes concurrently; reading them one after the other would block the
+ // remaining workers as soon as their pipe buffers are full.
+    std::vector<std::vector<unsigned char> > buffers(fds.size());
+    std::vector<struct pollfd> pollfds(fds.size());
+    for (size_t w = 0; w < fds.size(); w++)
+    {
+        pollfds[w].fd = fds[w];
+        pollfds[w].events = POLLIN;
+        pollfds[w].revents = 0;
+    }
+    size_t open_fds = fds.size();
+    unsigned char chunk[65536];
+    while (open_fds > 0)
+    {
+        if (poll(&pollfds[0], pollfds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("MultiProcessTraversal: poll");
+            break;
+        }
+        for (size_t w = 0; w < pollfds.size(); w++)
+        {
+            if (pollfds[w].fd < 0 || pollfds[w].revents == 0)
+                continue;
+            ssize_t n = read(pollfds[w].fd, chunk, sizeof chunk);
+            if (n > 0)
+            {
+                buffers[w].insert(buffers[w].end(), chunk, chunk + n);
+            }
+            else if (n == 0 || errno != EINTR)
+            {
+                close(pollfds[w].fd);
+                pollfds[w].fd = -1;         // poll ignores negative descriptors
+                open_fds--;
+            }
+        }
+    }
+    for (size_t w = 0; w < pollfds.size(); w++)
+        if (pollfds[w].fd >= 0)
+            close(pollfds[w].fd);
+
+ // Unpack the records. A worker that died leaves a truncated last record, which is ignored.
+    for (size_t w = 0; w < buffers.size(); w++)
+    {
+        const std::vector<unsigned char> &buffer = buffers[w];
+        size_t pos = 0;
+        while (buffer.size() - pos >= sizeof(MultiProcessAnalysisSupport::RecordHeader))
+        {
+            MultiProcessAnalysisSupport::RecordHeader header;
+            std::memcpy(&header, &buffer[pos], sizeof header);
+            pos += sizeof header;
+            if (header.functionIndex < 0 || (size_t) header.functionIndex >= results.size() || header.size < 0
+                || buffer.size() - pos < (size_t) header.size)
+                break;
+            results[header.functionIndex].assign(buffer.begin() + pos, buffer.begin() + pos + header.size);
+            haveResult[header.functionIndex] = true;
+            pos += header.size;
+        }
+    }
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+MultiProcessTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal)
+{
+    /* see what functions to run our analysis on */
+    DistributedMemoryAnalysisPreTraversal<InheritedAttributeType> nodeCounter(preTraversal);
+    nodeCounter.traverse(root, rootInheritedValue);
+
+    funcDecls = nodeCounter.get_funcDecls();
+    initialInheritedValues = nodeCounter.get_initialInheritedValues();
+    std::vector<size_t> &nodeCounts = nodeCounter.get_nodeCounts();
+    std::vector<size_t> &funcWeights = nodeCounter.get_funcWeights();
+    ROSE_ASSERT(funcDecls.size() == initialInheritedValues.size());
+    ROSE_ASSERT(funcDecls.size() == nodeCounts.size());
+    ROSE_ASSERT(funcDecls.size() == funcWeights.size());
+
+    size_t functions = funcDecls.size();
+    std::vector<std::vector<unsigned char> > results(functions);
+    std::vector<bool> haveResult(functions, false);
+
+    /* distribute the functions over the worker processes */
+    size_t workers = std::min((size_t) processes, functions);
+    if (workers > 1)
+    {
+        std::vector<std::vector<size_t> > functionsOfWorker(workers);
+        assignFunctions(nodeCounts, funcWeights, functionsOfWorker);
+
+     // Buffered output would otherwise be written by the parent and again by each worker.
+        std::cout.flush();
+        std::cerr.flush();
+        fflush(NULL);
+
+        std::vector<int> fds;
+        std::vector<pid_t> pids;
+        for (size_t w = 0; w < workers; w++)
+        {
+            int p[2];
+            if (pipe(p) != 0)
+            {
+                perror("MultiProcessTraversal: pipe");
+                break;
+            }
+            pid_t pid = fork();
+            if (pid < 0)
+            {
+                perror("MultiProcessTraversal: fork");
+                close(p[0]);
+                close(p[1]);
+                break;
+            }
+            if (pid == 0)
+            {
+                close(p[0]);
+                for (size_t k = 0; k < fds.size(); k++)
+                    close(fds[k]);
+                runWorker(w, functionsOfWorker[w], p[1]);   // does not return
+            }
+            close(p[1]);
+            fds.push_back(p[0]);
+            pids.push_back(pid);
+        }
+
+        collectResults(fds, results, haveResult);
+
+        for (size_t w = 0; w < pids.size(); w++)
+        {
+            int status = 0;
+            pid_t waited;
+            while ((waited = waitpid(pids[w], &status, 0)) < 0 && errno == EINTR)
+                ;
+            /* a worker that cannot be waited for (e.g., ECHILD) counts as failed */
+            if (waited != pids[w] || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                std::cerr << "MultiProcessTraversal: worker " << w << " failed, its remaining functions are analyzed "
+                          << "in the parent process" << std::endl;
+        }
+    }
+
+    /* unpack the results in function order; functions without a result (single process, failed
+     * fork or failed worker) are analyzed in this process */
+    std::vector<SynthesizedAttributeType> functionResults;
+    functionResults.reserve(functions);
+    for (size_t i = 0; i < functions; i++)
+    {
+        if (haveResult[i])
+        {
+            void *data = results[i].empty() ? NULL : &results[i][0];
+            functionResults.push_back(deserializeAttribute(std::make_pair((int) results[i].size(), data)));
+        }
+        else
+        {
+            functionResults.push_back(analyzeSubtree(funcDecls[i], initialInheritedValues[i]));
+        }
+    }
+
+    /* perform the post traversal */
+    DistributedMemoryAnalysisPostTraversal<SynthesizedAttributeType> postT(postTraversal, functionResults);
+    finalResults = postT.traverse(root, false);
+}
+
+#endif
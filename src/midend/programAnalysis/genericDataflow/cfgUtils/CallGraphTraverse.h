@@ -401,7 +401,12 @@ class TraverseCallGraphDataflow : public TraverseCallGraph
         public:
         // list of functions that still remain to be processed;
         std::list<const CGFunction*> remaining;
-                
+        
+        protected:
+        // the functions currently in remaining, so that addToRemaining() does not need to scan the list
+        std::set<const CGFunction*> remainingSet;
+        
+        public:
         TraverseCallGraphDataflow(SgIncidenceDirectedGraph* graph);
         
         void traverse();
@@ -5,6 +5,7 @@
 
 #include <union_find.h>
 #include <list>
+#include <deque>
 #include <map>
 #include <string>
 #include <iostream>
@@ -61,14 +62,14 @@ class ECRmap {
    }; 
 
    // x = y
-   void x_eq_y(Variable x, Variable y) {
+   void x_eq_y(const Variable& x, const Variable& y) {
       ECR* t1 = get_ECR(x)->get_type();
       ECR* t2 = get_ECR(y)->get_type();
       if (t1 != t2)
          cjoin(t1, t2);
    }
    // x = & y
-   void x_eq_addr_y(Variable x, Variable y) {
+   void x_eq_addr_y(const Variable& x, const Variable& y) {
       ECR * t1 = get_ECR(x)->get_type();
       ECR * t2 = get_ECR(y);
       if (t1 != t2) {
@@ -76,7 +77,7 @@ class ECRmap {
       }
    }
    // x = *y
-   void x_eq_deref_y(Variable x, Variable y) {
+   void x_eq_deref_y(const Variable& x, const Variable& y) {
       ECR* t1 = get_ECR(x)->get_type();
       ECR* t2 = get_ECR(y)->get_type();
       if (t2->get_type() == BOT) {
@@ -90,7 +91,7 @@ class ECRmap {
       }
    }   
    // x = op(y1,...yn)
-   void x_eq_op_y(Variable x, const std::list<Variable>& y) {
+   void x_eq_op_y(const Variable& x, const std::list<Variable>& y) {
       ECR* t1 = get_ECR(x)->get_type();
       for (std::list<Variable>::const_iterator yp = y.begin();
            yp != y.end(); ++yp) {
@@ -99,7 +100,7 @@ class ECRmap {
       }
    }
   // allocate(x)
-  void allocate(Variable x) {
+  void allocate(const Variable& x) {
       ECR* t = get_ECR(x)->get_type();
       if (t->get_type() == BOT) {
           ECR* res = new_ECR();
@@ -107,7 +108,7 @@ class ECRmap {
       }
   }
   // *x = y
-  void deref_x_eq_y(Variable x, Variable y) {
+  void deref_x_eq_y(const Variable& x, const Variable& y) {
       ECR* t1 = get_ECR(x)->get_type();
       ECR* t2 = get_ECR(y)->get_type();
       if (t1->get_type() == BOT) {
@@ -120,7 +121,7 @@ class ECRmap {
       }
    }   
   // outParams = x (inparams)
-  void function_def_x(Variable x, const std::list<Variable>& inParams, const std::list<Variable>& outParams) 
+  void function_def_x(const Variable& x, const std::list<Variable>& inParams, const std::list<Variable>& outParams) 
    {
      ECR* t = get_ECR(x)->get_type();
      Lambda* l = t->get_lambda();
@@ -147,7 +148,7 @@ class ECRmap {
      } 
    }
   // x = p (y)
-  void function_call_p(Variable p, const std::list<Variable>& x, const std::list<Variable>& y)
+  void function_call_p(const Variable& p, const std::list<Variable>& x, const std::list<Variable>& y)
   {
      ECR* t = get_ECR(p)->get_type();
      Lambda* l = t->get_lambda();
@@ -163,7 +164,7 @@ class ECRmap {
            assert(p2 != y.end());
           ECR* cur = *p1;
           assert(cur != 0);
-          Variable v2 = *p2;
+          const Variable& v2 = *p2;
           if (v2 != "")
              join(cur->get_ecr(), get_ECR(v2)->get_type());
         }
@@ -174,7 +175,7 @@ class ECRmap {
            assert(p2 != x.end());
            ECR* cur = *p1;
           assert(cur != 0);
-          Variable v2 = *p2;
+          const Variable& v2 = *p2;
            if ( v2 != "")
            join(get_ECR(v2)->get_type(), cur->get_ecr());
         }
@@ -241,33 +242,36 @@ class ECRmap {
       }
    }
 
-   bool mayAlias(Variable x, Variable y) {
-      if (table.find(x) == table.end() || table.find(y) == table.end()) 
+   bool mayAlias(const Variable& x, const Variable& y) {
+      std::map<Variable, ECR*>::const_iterator px = table.find(x);
+      if (px == table.end()) 
+         return false;     
+      std::map<Variable, ECR*>::const_iterator py = table.find(y);
+      if (py == table.end()) 
          return false;     
       
-      if (table[x]->get_type() == table[y]->get_type())
+      if (px->second->get_type() == py->second->get_type())
          return true;
       else
          return false;
    }
-   virtual ~ECRmap() {
-      for (std::list<ECR*>::const_iterator p = ecrList.begin();
-           p != ecrList.end(); ++p) {
-          delete (*p);
-      }
-   }
+   virtual ~ECRmap() {}
 
  private:
   std::map<Variable, ECR*> table;
-  std::list<ECR*> ecrList;
-  std::list<Lambda> lambdaList;
-  ECR* get_ECR(Variable x) {
+  // ECRs and lambdas are allocated in chunks rather than one heap object each;
+  // a deque never moves its elements when growing at the end, so the
+  // pointers held by the union-find groups stay valid.
+  std::deque<ECR> ecrArena;
+  std::deque<Lambda> lambdaList;
+  ECR* get_ECR(const Variable& x) {
      assert(x != "");
-     std::map<Variable, ECR*>::const_iterator p = table.find(x);
+     // a single search of the table, also used as the insertion hint
+     std::map<Variable, ECR*>::iterator p = table.lower_bound(x);
      ECR* res = 0;
-     if (p == table.end()) {
+     if (p == table.end() || table.key_comp()(x, p->first)) {
         res = new_ECR();
-        table[x] = res;
+        table.insert(p, std::pair<const Variable, ECR*>(x, res));
      }
      else
         res = (*p).second;
@@ -276,8 +280,8 @@ class ECRmap {
      return res;
   }
   ECR* new_ECR() {
-     ecrList.push_back(new ECR());
-     return ecrList.back();
+     ecrArena.push_back(ECR());
+     return &ecrArena.back();
   }
   Lambda* new_Lambda() {
      lambdaList.push_back(Lambda());
@@ -286,14 +290,14 @@ class ECRmap {
   void set_lambda(Lambda* l,const std::list<Variable>& inParams, const std::list<Variable>& outParams) {
      for (std::list<Variable>::const_iterator p = inParams.begin();
           p != inParams.end(); ++p) {
-        Variable cur = *p;
+        const Variable& cur = *p;
         if (cur != "")
            l->get_inParams().push_back(get_ECR(cur)->get_type());
         else l->get_inParams().push_back(0);
      }
      for (std::list<Variable>::const_iterator p2 = outParams.begin();
           p2 != outParams.end(); ++p2) {
-        Variable cur = *p2;
+        const Variable& cur = *p2;
         if (cur != "")
            l->get_outParams().push_back(get_ECR(cur)->get_type());
         else
@@ -303,13 +307,12 @@ class ECRmap {
   void set_type(ECR * e, ECR * t) {
       e->set_type(t);
      assert(t != BOT && e->get_type() == t);
-      std::list<ECR*> pending = e->get_pending();
-      if (pending.size()) {
-         for (std::list<ECR*>::const_iterator p=pending.begin(); 
-              p != pending.end(); ++p) 
-            join(t, *p);
-         e->get_pending().clear();
-      }
+      // take the pending list over instead of copying it (this also clears it)
+      std::list<ECR*> pending;
+      pending.swap(e->get_pending());
+      for (std::list<ECR*>::const_iterator p=pending.begin(); 
+           p != pending.end(); ++p) 
+         join(t, *p);
    }
    
   void cjoin(ECR* e1, ECR* e2) {
@@ -372,13 +375,15 @@ class ECRmap {
       if (t1 == BOT) {
          e->set_type(t2);
          if (t2 == BOT) {
+            // the list of the ECR that is no longer a group representative is
+            // never looked at again, so its elements are moved rather than copied
             if (e == e2) {
                assert(pending != pending1);
-               pending->insert(pending->end(), pending1->begin(), pending1->end());
+               pending->splice(pending->end(), *pending1);
             }
             else if (e == e1) {
               assert(pending != pending2);
-               pending->insert(pending->end(), pending2->begin(), pending2->end());
+               pending->splice(pending->end(), *pending2);
             }
             else {
               assert(pending != pending2 && pending != pending1);
@@ -387,22 +392,23 @@ class ECRmap {
               }
          }
          else {
-           if (pending1->size()) {
-              for (std::list<ECR*>::const_iterator p=pending1->begin();
-                   p != pending1->end(); ++p) 
-                 join(e, *p);
-            }
+           // the nested joins may clear this list, so it is taken over before iterating
+           std::list<ECR*> waiting;
+           waiting.swap(*pending1);
+           for (std::list<ECR*>::const_iterator p=waiting.begin();
+                p != waiting.end(); ++p) 
+              join(e, *p);
             pending->clear();
         }
       }
       else {
          e->set_type(t1);
          if (t2 == BOT) {
-             if (pending2->size()) {
-               for (std::list<ECR*>::const_iterator p=pending2->begin();
-                    p != pending2->end(); ++p) 
-                  join(e, *p);
-             }
+             std::list<ECR*> waiting;
+             waiting.swap(*pending2);
+             for (std::list<ECR*>::const_iterator p=waiting.begin();
+                  p != waiting.end(); ++p) 
+                join(e, *p);
          }
          else
             unify(t1, t2);
@@ -13,5 +13,5 @@ class ROSE_DLL_API CreateSliceSet
         protected:
                 SystemDependenceGraph *sdg;
                 std::list<SgNode*> sliceTargetNodes;
-                std::set<DependenceNode*> getSliceDepNodes(std::set <DependenceNode*> searchSet,std::set<DependenceGraph::EdgeType> allowedEdges);
+                std::set<DependenceNode*> getSliceDepNodes(const std::set <DependenceNode*> & searchSet,const std::set<DependenceGraph::EdgeType> & allowedEdges);
 };
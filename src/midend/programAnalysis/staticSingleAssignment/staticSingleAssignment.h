@@ -164,6 +164,10 @@ private:
      * the values here cannot be used during interprocedural analysis.  */
     boost::unordered_map<SgNode*, NodeReachingDefTable> ssaLocalDefTable;
 
+    /** Memoized results of isVarInScope() used during def propagation, keyed on the root variable of the name
+     * and the accessing node (isVarInScope only depends on those). Cleared for every function. */
+    boost::unordered_map<std::pair<SgInitializedName*, SgNode*>, bool> varInScopeCache;
+
 public:
 
     StaticSingleAssignment(SgProject* proj) : project(proj)
@@ -465,6 +469,12 @@ public:
      * variable is accessible there. False if the variable is not accessible. */
     static bool isVarInScope(const VarName& var, SgNode* scope);
 
+private:
+    /** Memoized version of isVarInScope() used by the dataflow propagation. */
+    bool isVarInScopeCached(const VarName& var, SgNode* astNode);
+
+public:
+
     /** Get a string representation of a varName.
      *
      * @param vec varName to get string for.
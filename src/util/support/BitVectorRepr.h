@@ -16,10 +16,13 @@ class BitVectorReprImpl {
   
   void operator = ( const BitVectorReprImpl& that)
   {}
+  // number of members packed into each word of impl (this used to be sizeof(unsigned),
+  // i.e. only 4 bits of each 32-bit word were used)
+  static unsigned bits_per_word() { return sizeof(unsigned) * 8; }
  public:
   BitVectorReprImpl( unsigned size)
     { 
-      unsigned intsize = sizeof(unsigned);
+      unsigned intsize = bits_per_word();
       num = (size + intsize-1) / intsize ;
       impl = new unsigned[num];
       for (unsigned i = 0; i < num; ++i) { 
@@ -83,26 +86,26 @@ class BitVectorReprImpl {
   
   bool has_member( unsigned index)  const
     {
-      unsigned intsize = sizeof(unsigned);
+      unsigned intsize = bits_per_word();
       int i1 = index / intsize;
       int i2 = index % intsize;
-      unsigned mask = 1 << i2;
+      unsigned mask = 1u << i2;
       return impl[i1] & mask;
     }
   void add_member( unsigned index)  
     {
-      unsigned intsize = sizeof(unsigned);
+      unsigned intsize = bits_per_word();
       int i1 = index / intsize;
       int i2 = index % intsize;
-      unsigned mask = 1 << i2;
+      unsigned mask = 1u << i2;
       impl[i1] |= mask;
     }
   void delete_member( unsigned index)
     {
-      unsigned intsize = sizeof(unsigned);
+      unsigned intsize = bits_per_word();
       int i1 = index / intsize;
       int i2 = index % intsize;
-      unsigned mask = ~(1 << i2);
+      unsigned mask = ~(1u << i2);
       impl[i1] &= mask;
     }
 };